@@ -0,0 +1,52 @@
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "linked_list.h"
+#include "typed_queue.h"
+
+typedef enum {
+    EVENT_COMPLETION, // job completion event
+    EVENT_ARRIVAL // job arrival event
+} event_type_t;
+
+// Event callback type
+// Callback function will be called at the scheduled time with the provided callbackData
+typedef void (*event_callback)(void* callbackData);
+
+typedef struct {
+    uint64_t timestamp; // time at which callback is invoked
+    event_type_t type; // event type
+    uint64_t id; // event id
+    event_callback callback; // callback to invoke
+    void* callbackData; // data to pass to callback
+    size_t queueIndex; // position of the event in array based event queues
+    list_node_t queueNode; // intrusive node linking the event into the arrival stream
+    bool arrivalStream; // true if the event is in the arrival stream instead of the event queue
+} event_t;
+
+// Event order packed into one integer, time in the high half, then type, then id
+// Ids are handed out one at a time from zero, so they stay well below 2^63
+typedef unsigned __int128 event_key_t;
+
+// Returns the key of an event, events compare with a single integer comparison
+static inline event_key_t eventKey(const event_t* event)
+{
+    return (event_key_t)event->timestamp << 64 | (event_key_t)event->type << 63 | event->id;
+}
+
+// Returns true if event1 goes before event2
+// Events are sorted by (time, type, id)
+static inline bool eventBefore(const event_t* event1, const event_t* event2)
+{
+    return eventKey(event1) < eventKey(event2);
+}
+
+#define EVENT_DEQUE_KEY(entry) eventKey(*(entry))
+
+// Sorted deque of events by (time, type, id)
+DEFINE_SORTED_DEQUE(event_deque_t, eventDeque, event_t*, event_key_t, EVENT_DEQUE_KEY)
+
+#endif /* EVENT_H */
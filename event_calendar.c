@@ -0,0 +1,237 @@
+#include <stdlib.h>
+#include "event_calendar.h"
+
+#define EVENT_CALENDAR_MIN_BUCKETS 16
+#define EVENT_CALENDAR_SAMPLE_SIZE 25
+
+// Returns the bucket an event with the given timestamp belongs in
+static inline size_t eventCalendarBucket(event_calendar_t* calendar, uint64_t timestamp)
+{
+    return (size_t)(timestamp / calendar->width) & (calendar->numBuckets - 1);
+}
+
+// Points the day scan at the day containing the given time
+static void eventCalendarSeek(event_calendar_t* calendar, uint64_t timestamp)
+{
+    calendar->lastBucket = eventCalendarBucket(calendar, timestamp);
+    calendar->bucketTop = (timestamp / calendar->width + 1) * calendar->width;
+}
+
+// Allocates numBuckets empty buckets
+// A bucket only allocates once an event lands in it
+// Returns the bucket array on success, NULL otherwise
+static event_deque_t* eventCalendarCreateBuckets(size_t numBuckets)
+{
+    event_deque_t* buckets = malloc(numBuckets * sizeof(event_deque_t));
+    if (buckets == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < numBuckets; i++) {
+        eventDequeInit(&buckets[i]);
+    }
+    return buckets;
+}
+
+// Destroys numBuckets buckets
+static void eventCalendarDestroyBuckets(event_deque_t* buckets, size_t numBuckets)
+{
+    for (size_t i = 0; i < numBuckets; i++) {
+        eventDequeFree(&buckets[i]);
+    }
+    free(buckets);
+}
+
+// Returns the earliest event in a bucket, or NULL if the bucket is empty
+static inline event_t* eventCalendarBucketHead(event_deque_t* bucket)
+{
+    return eventDequeCount(bucket) > 0 ? *eventDequeFront(bucket) : NULL;
+}
+
+// Estimates a bucket width from the average separation of the earliest events
+// Large gaps are ignored so a few far future events don't stretch the days
+static uint64_t eventCalendarSampleWidth(event_calendar_t* calendar)
+{
+    uint64_t samples[EVENT_CALENDAR_SAMPLE_SIZE];
+    size_t numSamples = 0;
+    // Keep the smallest timestamps in sorted order
+    for (size_t i = 0; i < calendar->numBuckets; i++) {
+        event_deque_t* bucket = &calendar->buckets[i];
+        for (size_t k = 0; k < eventDequeCount(bucket); k++) {
+            uint64_t timestamp = (*eventDequeAt(bucket, k))->timestamp;
+            if (numSamples < EVENT_CALENDAR_SAMPLE_SIZE || timestamp < samples[numSamples - 1]) {
+                size_t j = numSamples < EVENT_CALENDAR_SAMPLE_SIZE ? numSamples++ : numSamples - 1;
+                while (j > 0 && samples[j - 1] > timestamp) {
+                    samples[j] = samples[j - 1];
+                    j--;
+                }
+                samples[j] = timestamp;
+            }
+        }
+    }
+    if (numSamples < 2) {
+        return calendar->width;
+    }
+    uint64_t average = (samples[numSamples - 1] - samples[0]) / (numSamples - 1);
+    uint64_t total = 0;
+    uint64_t gaps = 0;
+    for (size_t i = 1; i < numSamples; i++) {
+        uint64_t gap = samples[i] - samples[i - 1];
+        if (gap <= 2 * average) {
+            total += gap;
+            gaps++;
+        }
+    }
+    uint64_t width = gaps > 0 ? 3 * total / gaps : 0;
+    return width > 0 ? width : 1;
+}
+
+// Rebuilds the calendar with numBuckets buckets and a freshly sampled width
+static void eventCalendarResize(event_calendar_t* calendar, size_t numBuckets)
+{
+    event_deque_t* buckets = eventCalendarCreateBuckets(numBuckets);
+    if (buckets == NULL) {
+        // Keep the current layout, it is still correct just slower
+        return;
+    }
+    uint64_t width = eventCalendarSampleWidth(calendar);
+    event_calendar_t old = *calendar;
+    calendar->buckets = buckets;
+    calendar->numBuckets = numBuckets;
+    calendar->width = width;
+    calendar->count = 0;
+    calendar->resizeEnabled = false;
+    for (size_t i = 0; i < old.numBuckets; i++) {
+        // Events are copied over in order, so most inserts land at the back of their bucket
+        for (size_t k = 0; k < eventDequeCount(&old.buckets[i]); k++) {
+            if (!eventCalendarPush(calendar, *eventDequeAt(&old.buckets[i], k))) {
+                // Keep the current layout, the old buckets are untouched
+                eventCalendarDestroyBuckets(buckets, numBuckets);
+                *calendar = old;
+                return;
+            }
+        }
+    }
+    calendar->resizeEnabled = true;
+    calendar->directSearches = 0;
+    eventCalendarSeek(calendar, calendar->lastTime);
+    eventCalendarDestroyBuckets(old.buckets, old.numBuckets);
+}
+
+// Finds the earliest event and the day it is in
+// Returns NULL if the queue is empty
+static event_t* eventCalendarFindMin(event_calendar_t* calendar, size_t* bucket, uint64_t* bucketTop)
+{
+    if (calendar->count == 0) {
+        return NULL;
+    }
+    // Scan one year of days starting at the current day
+    size_t i = calendar->lastBucket;
+    uint64_t top = calendar->bucketTop;
+    for (size_t n = 0; n < calendar->numBuckets; n++) {
+        event_t* event = eventCalendarBucketHead(&calendar->buckets[i]);
+        if (event != NULL && event->timestamp < top) {
+            *bucket = i;
+            *bucketTop = top;
+            return event;
+        }
+        i = (i + 1) & (calendar->numBuckets - 1);
+        top += calendar->width;
+    }
+    // Nothing within a year, so directly search the heads of all buckets
+    calendar->directSearches++;
+    event_t* min = NULL;
+    for (i = 0; i < calendar->numBuckets; i++) {
+        event_t* event = eventCalendarBucketHead(&calendar->buckets[i]);
+        if (event != NULL && (min == NULL || eventBefore(event, min))) {
+            min = event;
+        }
+    }
+    *bucket = eventCalendarBucket(calendar, min->timestamp);
+    *bucketTop = (min->timestamp / calendar->width + 1) * calendar->width;
+    return min;
+}
+
+// Creates and returns an empty calendar queue
+event_calendar_t* eventCalendarCreate()
+{
+    event_calendar_t* calendar = malloc(sizeof(event_calendar_t));
+    if (calendar == NULL) {
+        return NULL;
+    }
+    calendar->buckets = eventCalendarCreateBuckets(EVENT_CALENDAR_MIN_BUCKETS);
+    if (calendar->buckets == NULL) {
+        free(calendar);
+        return NULL;
+    }
+    calendar->numBuckets = EVENT_CALENDAR_MIN_BUCKETS;
+    calendar->width = 1;
+    calendar->count = 0;
+    calendar->resizeEnabled = true;
+    calendar->lastTime = 0;
+    calendar->directSearches = 0;
+    eventCalendarSeek(calendar, 0);
+    return calendar;
+}
+
+// Destroys a calendar queue
+// Events still in the queue are not freed
+void eventCalendarDestroy(event_calendar_t* calendar)
+{
+    eventCalendarDestroyBuckets(calendar->buckets, calendar->numBuckets);
+    free(calendar);
+}
+
+// Returns the earliest event without removing it, or NULL if the queue is empty
+event_t* eventCalendarPeek(event_calendar_t* calendar)
+{
+    size_t bucket;
+    uint64_t bucketTop;
+    return eventCalendarFindMin(calendar, &bucket, &bucketTop);
+}
+
+// Inserts an event into the calendar queue
+// Returns true on success, false otherwise
+bool eventCalendarPush(event_calendar_t* calendar, event_t* event)
+{
+    event_deque_t* bucket = &calendar->buckets[eventCalendarBucket(calendar, event->timestamp)];
+    if (!eventDequeInsert(bucket, event)) {
+        return false;
+    }
+    calendar->count++;
+    if (calendar->resizeEnabled && calendar->count > 2 * calendar->numBuckets) {
+        eventCalendarResize(calendar, 2 * calendar->numBuckets);
+    }
+    return true;
+}
+
+// Removes and returns the earliest event, or NULL if the queue is empty
+event_t* eventCalendarPop(event_calendar_t* calendar)
+{
+    size_t bucket;
+    uint64_t bucketTop;
+    event_t* event = eventCalendarFindMin(calendar, &bucket, &bucketTop);
+    if (event == NULL) {
+        return NULL;
+    }
+    // Later events can't be scheduled before this one, so resume the scan from its day
+    calendar->lastBucket = bucket;
+    calendar->bucketTop = bucketTop;
+    calendar->lastTime = event->timestamp;
+    eventCalendarRemove(calendar, event);
+    // Frequent direct searches mean the days are too narrow for the current events
+    if (calendar->resizeEnabled && calendar->directSearches > calendar->numBuckets) {
+        eventCalendarResize(calendar, calendar->numBuckets);
+    }
+    return event;
+}
+
+// Removes the given event from the calendar queue
+void eventCalendarRemove(event_calendar_t* calendar, event_t* event)
+{
+    event_t* removed;
+    eventDequeRemove(&calendar->buckets[eventCalendarBucket(calendar, event->timestamp)], eventKey(event), &removed);
+    calendar->count--;
+    if (calendar->resizeEnabled && calendar->numBuckets > EVENT_CALENDAR_MIN_BUCKETS && calendar->count < calendar->numBuckets / 2) {
+        eventCalendarResize(calendar, calendar->numBuckets / 2);
+    }
+}
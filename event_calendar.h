@@ -0,0 +1,52 @@
+#ifndef EVENT_CALENDAR_H
+#define EVENT_CALENDAR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "event.h"
+
+// Calendar queue of events ordered by (time, type, id)
+// Events are hashed by timestamp into buckets ("days") of a fixed width, and the buckets
+// are scanned in order one "year" at a time. Each bucket is a sorted deque, so ties are
+// broken exactly as in the other event queues. The bucket count and width are resized as
+// the queue grows and shrinks to keep enqueue and dequeue O(1) amortized.
+typedef struct {
+    event_deque_t* buckets; // buckets sorted by (time, type, id)
+    size_t numBuckets; // number of buckets, always a power of two
+    uint64_t width; // time span covered by one bucket
+    size_t count; // number of events in the queue
+    size_t lastBucket; // bucket of the last dequeued event
+    uint64_t bucketTop; // end time of the current day of lastBucket
+    uint64_t lastTime; // time of the last dequeued event
+    size_t directSearches; // year scans that found nothing since the last resize
+    bool resizeEnabled; // disables resizing while the buckets are being rebuilt
+} event_calendar_t;
+
+// Creates and returns an empty calendar queue
+event_calendar_t* eventCalendarCreate();
+
+// Destroys a calendar queue
+// Events still in the queue are not freed
+void eventCalendarDestroy(event_calendar_t* calendar);
+
+// Returns the number of events in the calendar queue
+static inline size_t eventCalendarCount(event_calendar_t* calendar)
+{
+    return calendar->count;
+}
+
+// Returns the earliest event without removing it, or NULL if the queue is empty
+event_t* eventCalendarPeek(event_calendar_t* calendar);
+
+// Inserts an event into the calendar queue
+// Returns true on success, false otherwise
+bool eventCalendarPush(event_calendar_t* calendar, event_t* event);
+
+// Removes and returns the earliest event, or NULL if the queue is empty
+event_t* eventCalendarPop(event_calendar_t* calendar);
+
+// Removes the given event from the calendar queue
+void eventCalendarRemove(event_calendar_t* calendar, event_t* event);
+
+#endif /* EVENT_CALENDAR_H */
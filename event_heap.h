@@ -0,0 +1,48 @@
+#ifndef EVENT_HEAP_H
+#define EVENT_HEAP_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "event.h"
+
+// Binary min-heap of events ordered by (time, type, id)
+// Each event records its own position in the heap so it can be removed in O(log n)
+typedef struct {
+    event_t** events; // heap array of events
+    size_t count; // number of events in the heap
+    size_t capacity; // allocated slots in the heap array
+} event_heap_t;
+
+// Creates and returns an empty event heap
+event_heap_t* eventHeapCreate();
+
+// Destroys an event heap
+// Events still in the heap are not freed
+void eventHeapDestroy(event_heap_t* heap);
+
+// Returns the number of events in the heap
+static inline size_t eventHeapCount(event_heap_t* heap)
+{
+    return heap->count;
+}
+
+// Returns the earliest event without removing it, or NULL if the heap is empty
+static inline event_t* eventHeapPeek(event_heap_t* heap)
+{
+    return heap->count > 0 ? heap->events[0] : NULL;
+}
+
+// Inserts an event into the heap in O(log n)
+// Returns true on success, false otherwise
+bool eventHeapPush(event_heap_t* heap, event_t* event);
+
+// Removes and returns the earliest event, or NULL if the heap is empty
+event_t* eventHeapPop(event_heap_t* heap);
+
+// Removes the given event from the heap in O(log n)
+void eventHeapRemove(event_heap_t* heap, event_t* event);
+
+// Restores the heap order in O(log n) after the key of the given event changed
+void eventHeapUpdate(event_heap_t* heap, event_t* event);
+
+#endif /* EVENT_HEAP_H */
@@ -0,0 +1,54 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "event.h"
+#include "event_heap.h"
+#include "event_calendar.h"
+
+// Event queue backends
+// All backends dispatch events in the same (time, type, id) order
+typedef enum {
+    EVENT_QUEUE_HEAP, // binary heap, O(log n) schedule and remove
+    EVENT_QUEUE_CALENDAR, // calendar queue, O(1) amortized for dense, roughly uniform timestamps
+    EVENT_QUEUE_LIST // sorted array, O(n) schedule
+} event_queue_type_t;
+
+typedef struct {
+    event_queue_type_t type; // backend type
+    union {
+        event_heap_t* heap; // EVENT_QUEUE_HEAP backend
+        event_calendar_t* calendar; // EVENT_QUEUE_CALENDAR backend
+        event_deque_t* list; // EVENT_QUEUE_LIST backend
+    };
+} event_queue_t;
+
+// Creates and returns an empty event queue of the given type
+event_queue_t* eventQueueCreate(event_queue_type_t type);
+
+// Destroys an event queue
+// Events still in the queue are not freed
+void eventQueueDestroy(event_queue_t* queue);
+
+// Returns the number of events in the queue
+size_t eventQueueCount(event_queue_t* queue);
+
+// Returns the earliest event without removing it, or NULL if the queue is empty
+event_t* eventQueuePeek(event_queue_t* queue);
+
+// Inserts an event into the queue
+// Returns true on success, false otherwise
+bool eventQueuePush(event_queue_t* queue, event_t* event);
+
+// Removes and returns the earliest event, or NULL if the queue is empty
+event_t* eventQueuePop(event_queue_t* queue);
+
+// Removes the given event from the queue
+void eventQueueRemove(event_queue_t* queue, event_t* event);
+
+// Moves a queued event to a new (timestamp, id) key in place
+// Returns true on success, false if the event couldn't be reinserted and has left the queue
+bool eventQueueUpdate(event_queue_t* queue, event_t* event, uint64_t timestamp, uint64_t id);
+
+#endif /* EVENT_QUEUE_H */
@@ -0,0 +1,179 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "simulator.h"
+
+// Event queue benchmark using the classic hold model
+// A fixed number of pending events is kept in the queue and each dispatched event schedules
+// one replacement a random interval later until the requested number of events has run.
+// The dispatch order is hashed so every backend can be checked against the others.
+// Allocator calls are counted by linking with --wrap for malloc, calloc and realloc.
+
+#define BENCH_MEAN_SPACING 10 // mean time between consecutive pending events
+#define BENCH_MAX_LIST_PENDING 1024 // larger queues take too long with the O(n) list backend
+
+static uint64_t benchAllocs = 0; // allocator calls made through the wrappers below
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t num, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+// Counts and forwards malloc calls
+void* __wrap_malloc(size_t size)
+{
+    benchAllocs++;
+    return __real_malloc(size);
+}
+
+// Counts and forwards calloc calls
+void* __wrap_calloc(size_t num, size_t size)
+{
+    benchAllocs++;
+    return __real_calloc(num, size);
+}
+
+// Counts and forwards realloc calls
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    benchAllocs++;
+    return __real_realloc(ptr, size);
+}
+
+typedef struct bench bench_t;
+
+// A pending event slot that reschedules itself on every dispatch
+typedef struct {
+    bench_t* bench; // owning benchmark
+    uint64_t index; // slot index, hashed into the dispatch order
+} bench_token_t;
+
+struct bench {
+    simulator_t* sim; // simulator under test
+    uint64_t remaining; // events left to schedule
+    uint64_t maxGap; // largest interval between an event and its replacement
+    uint64_t rng; // xorshift random state
+    uint64_t checksum; // hash of the dispatch order
+    bool failed; // an event could not be scheduled
+};
+
+// Returns the next pseudo random number
+static uint64_t benchRandom(bench_t* bench)
+{
+    bench->rng ^= bench->rng << 13;
+    bench->rng ^= bench->rng >> 7;
+    bench->rng ^= bench->rng << 17;
+    return bench->rng;
+}
+
+// Schedules the token a random interval after the current time
+static void benchScheduleToken(bench_token_t* token);
+
+// Called when a token's event is dispatched
+static void benchCallback(void* data)
+{
+    bench_token_t* token = (bench_token_t*)data;
+    bench_t* bench = token->bench;
+    bench->checksum = (bench->checksum ^ (simulatorSimTime(bench->sim) * 31 + token->index)) * 0x100000001b3ULL;
+    if (bench->remaining > 0) {
+        benchScheduleToken(token);
+    }
+}
+
+static void benchScheduleToken(bench_token_t* token)
+{
+    bench_t* bench = token->bench;
+    uint64_t r = benchRandom(bench);
+    uint64_t gap = r % (bench->maxGap + 1);
+    // Mix event types so (time, type, id) tie breaking is exercised
+    event_type_t type = (r >> 32) & 1 ? EVENT_ARRIVAL : EVENT_COMPLETION;
+    bench->remaining--;
+    if (simulatorSchedule(bench->sim, simulatorSimTime(bench->sim) + gap, type, benchCallback, token) == NULL) {
+        // Stop scheduling so the pending events drain and the run ends
+        bench->failed = true;
+        bench->remaining = 0;
+    }
+}
+
+// Returns the elapsed time in seconds between two timestamps
+static double benchSeconds(struct timespec* start, struct timespec* end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// Runs one configuration and prints a CSV row
+// Returns false if the simulator could not be created or an event could not be scheduled
+static bool benchRun(const char* name, event_queue_type_t queueType, uint64_t events, uint64_t pending)
+{
+    bench_t bench;
+    bench.sim = simulatorCreate(queueType);
+    if (bench.sim == NULL) {
+        return false;
+    }
+    bench.remaining = events;
+    bench.maxGap = 2 * BENCH_MEAN_SPACING * pending;
+    bench.rng = 0x9e3779b97f4a7c15ULL;
+    bench.checksum = 0xcbf29ce484222325ULL;
+    bench.failed = false;
+    bench_token_t* tokens = malloc(pending * sizeof(bench_token_t));
+    if (tokens == NULL) {
+        simulatorDestroy(bench.sim);
+        return false;
+    }
+    struct timespec start;
+    struct timespec end;
+    uint64_t allocs = benchAllocs;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint64_t i = 0; i < pending && bench.remaining > 0; i++) {
+        tokens[i].bench = &bench;
+        tokens[i].index = i;
+        benchScheduleToken(&tokens[i]);
+    }
+    simulatorRun(bench.sim);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    allocs = benchAllocs - allocs;
+    if (bench.failed) {
+        fprintf(stderr, "%s, %" PRIu64 ", %" PRIu64 ": could not schedule an event\n", name, events, pending);
+        free(tokens);
+        simulatorDestroy(bench.sim);
+        return false;
+    }
+    double seconds = benchSeconds(&start, &end);
+    printf("%s, %" PRIu64 ", %" PRIu64 ", %.3f, %.1f, %" PRIu64 ", %016" PRIx64 "\n", name, events, pending, seconds, seconds * 1e9 / (double)events, allocs, bench.checksum);
+    fflush(stdout);
+    free(tokens);
+    simulatorDestroy(bench.sim);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    uint64_t eventCounts[] = {1000000, 10000000};
+    uint64_t pendingCounts[] = {16, 1024, 65536};
+    size_t numEventCounts = sizeof(eventCounts) / sizeof(eventCounts[0]);
+    size_t numPendingCounts = sizeof(pendingCounts) / sizeof(pendingCounts[0]);
+    if (argc == 3) {
+        eventCounts[0] = strtoull(argv[1], NULL, 10);
+        pendingCounts[0] = strtoull(argv[2], NULL, 10);
+        numEventCounts = 1;
+        numPendingCounts = 1;
+    } else if (argc != 1) {
+        printf("%s [events pending]\n", argv[0]);
+        return -1;
+    }
+    printf("queue, events, pending, seconds, ns_per_event, allocs, order_checksum\n");
+    for (size_t i = 0; i < numEventCounts; i++) {
+        for (size_t j = 0; j < numPendingCounts; j++) {
+            uint64_t events = eventCounts[i];
+            uint64_t pending = pendingCounts[j];
+            if (pending <= BENCH_MAX_LIST_PENDING && !benchRun("list", EVENT_QUEUE_LIST, events, pending)) {
+                return -2;
+            }
+            if (!benchRun("heap", EVENT_QUEUE_HEAP, events, pending) ||
+                !benchRun("calendar", EVENT_QUEUE_CALENDAR, events, pending)) {
+                return -2;
+            }
+        }
+    }
+    return 0;
+}
@@ -11,16 +11,49 @@ sandbox_dir = "sandbox"
 
 # Location of original files and the files to copy
 original_dir = "."
-files_to_copy = ["job.h",
+files_to_copy = ["completion_sort.c",
+                 "completion_sort.h",
+                 "event.h",
+                 "event_arena.c",
+                 "event_arena.h",
+                 "event_calendar.c",
+                 "event_calendar.h",
+                 "event_heap.c",
+                 "event_heap.h",
+                 "event_queue.c",
+                 "event_queue.h",
+                 "event_queue_bench.c",
+                 "job.h",
+                 "job_deque.h",
+                 "job_heap.h",
+                 "job_store.c",
+                 "job_store.h",
                  "linked_list_test.c",
                  "main.c",
                  "Makefile",
                  "scheduler.c",
                  "scheduler.h",
+                 "scheduler_bench.c",
                  "simulator.c",
                  "simulator.h",
                  "trace.c",
-                 "trace.h"]
+                 "trace.h",
+                 "trace_batch.c",
+                 "trace_batch.h",
+                 "trace_binary.h",
+                 "trace_chunks.c",
+                 "trace_chunks.h",
+                 "trace_convert.c",
+                 "trace_gen.c",
+                 "trace_reader.c",
+                 "trace_reader.h",
+                 "trace_ring.c",
+                 "trace_ring.h",
+                 "trace_writer.c",
+                 "trace_writer.h",
+                 "typed_queue.h",
+                 "workload.c",
+                 "workload.h"]
 
 # Handin files
 handin_files = ["linked_list.c",
@@ -56,6 +89,8 @@ add_test_cases("test_list_create")
 add_test_cases("test_list_insert")
 add_test_cases("test_list_find")
 add_test_cases("test_list_remove")
+add_test_cases("test_list_intrusive")
+add_test_cases("test_list_pooled")
 
 def add_test_cases_trace(test_name, policy, input_file):
     output_file = f"{input_file}.out"
@@ -3,6 +3,9 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include "linked_list.h"
+
+#define JOB_INDEX_NONE UINT32_MAX // index of a job that is not in a job store
 
 // Job information
 // DO NOT DIRECTLY USE THESE FIELDS
@@ -12,17 +15,25 @@ typedef struct {
     uint64_t jobTime; // job time
     uint64_t remainingTime; // remaining job time
     uint64_t id; // job id
+    uint32_t index; // index of the job in its job store
+    list_node_t node; // intrusive node linking the job into a scheduler queue
 } job_t;
 
+// Initialize a job in caller provided storage
+static inline void jobInit(job_t* job, uint64_t arrivalTime, uint64_t jobTime, uint64_t id, uint32_t index)
+{
+    job->arrivalTime = arrivalTime;
+    job->jobTime = jobTime;
+    job->remainingTime = jobTime;
+    job->id = id;
+    job->index = index;
+}
 // Create a new job
 static inline job_t* jobCreate(uint64_t arrivalTime, uint64_t jobTime, uint64_t id)
 {
     job_t* job = malloc(sizeof(job_t));
     if (job) {
-        job->arrivalTime = arrivalTime;
-        job->jobTime = jobTime;
-        job->remainingTime = jobTime;
-        job->id = id;
+        jobInit(job, arrivalTime, jobTime, id, JOB_INDEX_NONE);
     }
     return job;
 }
@@ -61,5 +72,16 @@ static inline uint64_t jobGetId(job_t* job)
 {
     return job->id;
 }
+// Get the job's index in its job store, or JOB_INDEX_NONE for jobs from jobCreate
+static inline uint32_t jobGetIndex(job_t* job)
+{
+    return job->index;
+}
+// Get the intrusive list node embedded in the job
+// A job can be linked into one intrusive list at a time
+static inline list_node_t* jobGetNode(job_t* job)
+{
+    return &job->node;
+}
 
 #endif /* JOB_H */
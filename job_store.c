@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include "job_store.h"
+
+#define JOB_STORE_INITIAL_BLOCK_SLOTS 16
+
+// Creates and returns an empty job store
+job_store_t* jobStoreCreate()
+{
+    job_store_t* store = malloc(sizeof(job_store_t));
+    if (store == NULL) {
+        return NULL;
+    }
+    store->blocks = malloc(JOB_STORE_INITIAL_BLOCK_SLOTS * sizeof(job_t*));
+    store->freeJobs = list_create_intrusive(NULL);
+    if (store->blocks == NULL || store->freeJobs == NULL) {
+        if (store->freeJobs != NULL) {
+            list_destroy(store->freeJobs);
+        }
+        free(store->blocks);
+        free(store);
+        return NULL;
+    }
+    store->numBlocks = 0;
+    store->blockSlots = JOB_STORE_INITIAL_BLOCK_SLOTS;
+    store->count = 0;
+    return store;
+}
+
+// Destroys a job store and every job allocated from it
+void jobStoreDestroy(job_store_t* store)
+{
+    list_destroy(store->freeJobs);
+    for (size_t i = 0; i < store->numBlocks; i++) {
+        free(store->blocks[i]);
+    }
+    free(store->blocks);
+    free(store);
+}
+
+// Adds a block of jobs to the store
+// Returns true on success, false otherwise
+static bool jobStoreGrow(job_store_t* store)
+{
+    // The last index is reserved for JOB_INDEX_NONE
+    if ((uint64_t)store->count + JOB_STORE_BLOCK_JOBS > JOB_INDEX_NONE) {
+        return false;
+    }
+    if (store->numBlocks == store->blockSlots) {
+        size_t blockSlots = 2 * store->blockSlots;
+        job_t** blocks = realloc(store->blocks, blockSlots * sizeof(job_t*));
+        if (blocks == NULL) {
+            return false;
+        }
+        store->blocks = blocks;
+        store->blockSlots = blockSlots;
+    }
+    job_t* block = malloc(JOB_STORE_BLOCK_JOBS * sizeof(job_t));
+    if (block == NULL) {
+        return false;
+    }
+    store->blocks[store->numBlocks++] = block;
+    return true;
+}
+
+// Creates a new job in the store
+// Returns the job, or NULL if the store is full or out of memory
+job_t* jobStoreCreateJob(job_store_t* store, uint64_t arrivalTime, uint64_t jobTime, uint64_t id)
+{
+    job_t* job;
+    list_node_t* node = list_head(store->freeJobs);
+    if (node != NULL) {
+        // Reuse the most recently released job, its memory is likely still cached
+        job = (job_t*)list_data(node);
+        list_remove(store->freeJobs, node);
+    } else {
+        if (store->count == store->numBlocks * JOB_STORE_BLOCK_JOBS && !jobStoreGrow(store)) {
+            return NULL;
+        }
+        job = jobStoreGet(store, store->count++);
+        job->index = store->count - 1;
+    }
+    jobInit(job, arrivalTime, jobTime, id, job->index);
+    return job;
+}
+
+// Returns a job to the store for reuse
+// The job must not be linked into any list
+void jobStoreReleaseJob(job_store_t* store, job_t* job)
+{
+    list_insert_node(store->freeJobs, jobGetNode(job), job);
+}
@@ -35,9 +35,94 @@ list_t* list_create(compare_fn compare)
     listp->tail = NULL; 
     listp->count = 0; 
     listp->compare = compare; 
+    listp->intrusive = 0; 
+    listp->pool = NULL; 
     return listp;
 }
 
+// Creates and returns a new intrusive list
+// Nodes are embedded in the user data and linked with list_insert_node
+list_t* list_create_intrusive(compare_fn compare)
+{
+    list_t* listp = list_create(compare); 
+    if(listp != NULL)
+    {
+        listp->intrusive = 1; 
+    }
+    return listp;
+}
+
+// Creates and returns a new list that allocates its nodes from a private pool
+// Nodes are carved chunk_nodes at a time and recycled on removal
+list_t* list_create_pooled(compare_fn compare, size_t chunk_nodes)
+{
+    if(chunk_nodes == 0)
+    {
+        return NULL; 
+    }
+
+    list_pool_t* pool = malloc(sizeof(list_pool_t)); 
+    if(pool == NULL)
+    {
+        return NULL; 
+    }
+    pool->free_nodes = NULL; 
+    pool->chunks = NULL; 
+    pool->chunk_nodes = chunk_nodes; 
+
+    list_t* listp = list_create(compare); 
+    if(listp == NULL)
+    {
+        free(pool); 
+        return NULL; 
+    }
+    listp->pool = pool; 
+    return listp;
+}
+
+//Helper functions for getting nodes from and returning nodes to the list's allocator
+static list_node_t* alloc_node(list_t* list)
+{
+    list_pool_t* pool = list->pool; 
+    if(pool == NULL)
+    {
+        return malloc(sizeof(list_node_t)); 
+    }
+
+    //carve a new chunk into the free list once every recycled node is in use
+    if(pool->free_nodes == NULL)
+    {
+        list_pool_chunk_t* chunk = malloc(sizeof(list_pool_chunk_t) + pool->chunk_nodes * sizeof(list_node_t)); 
+        if(chunk == NULL)
+        {
+            return NULL; 
+        }
+        chunk->next = pool->chunks; 
+        pool->chunks = chunk; 
+        for(size_t i = 0; i < pool->chunk_nodes; i++)
+        {
+            chunk->nodes[i].next = pool->free_nodes; 
+            pool->free_nodes = &chunk->nodes[i]; 
+        }
+    }
+
+    list_node_t* node = pool->free_nodes; 
+    pool->free_nodes = node->next; 
+    return node;
+}
+
+static void free_node(list_t* list, list_node_t* node)
+{
+    list_pool_t* pool = list->pool; 
+    if(pool == NULL)
+    {
+        free(node); 
+        return; 
+    }
+    node->next = pool->free_nodes; 
+    pool->free_nodes = node; 
+}
+
 // Destroys a list
 void list_destroy(list_t* list)
 {
@@ -48,7 +133,8 @@ void list_destroy(list_t* list)
     }
     */
 
-    list_node_t* curr_node = list->head; 
+    //pooled nodes are released with their chunks below, so only other lists walk their nodes
+    list_node_t* curr_node = list->pool == NULL ? list->head : NULL; 
     while(curr_node != NULL)
     {
         list_node_t* node_to_remove = curr_node; 
@@ -60,6 +146,20 @@ void list_destroy(list_t* list)
     list->tail = NULL; 
     list->count = (size_t)NULL; 
     list->compare = NULL; 
+
+    //release every chunk of the node pool at once
+    if(list->pool != NULL)
+    {
+        list_pool_chunk_t* chunk = list->pool->chunks; 
+        while(chunk != NULL)
+        {
+            list_pool_chunk_t* chunk_to_free = chunk; 
+            chunk = chunk->next; 
+            free(chunk_to_free); 
+        }
+        free(list->pool); 
+        list->pool = NULL; 
+    }
     free(list); 
 }
 
@@ -201,16 +301,9 @@ int insert_new_node_after_given_node(list_t* list, list_node_t* new_node, list_n
     return 1; 
 }
 
-// Inserts a new node in the list with the given data
-// Returns new node inserted
-list_node_t* list_insert(list_t* list, void* data)
+//Links new_node into its sorted position in the list
+static list_node_t* link_new_node(list_t* list, list_node_t* new_node, void* data)
 {
-    if(list == NULL)
-    {
-        return NULL; 
-    }
-
-    list_node_t* new_node = malloc(sizeof(list_node_t)); 
     new_node->next = NULL;
     new_node->prev = NULL;
     new_node->data = data; 
@@ -256,7 +349,36 @@ list_node_t* list_insert(list_t* list, void* data)
     return new_node; 
 }
 
-// Removes a node from the list and frees the node resources
+// Inserts a new node in the list with the given data
+// Returns new node inserted
+list_node_t* list_insert(list_t* list, void* data)
+{
+    if(list == NULL || list->intrusive)
+    {
+        return NULL; 
+    }
+
+    list_node_t* new_node = alloc_node(list); 
+    if(new_node == NULL)
+    {
+        return NULL; 
+    }
+    return link_new_node(list, new_node, data); 
+}
+
+// Links a user-owned node holding the given data into an intrusive list
+// Returns the node inserted, or NULL if the list is not intrusive
+list_node_t* list_insert_node(list_t* list, list_node_t* node, void* data)
+{
+    if(list == NULL || node == NULL || !list->intrusive)
+    {
+        return NULL; 
+    }
+    return link_new_node(list, node, data); 
+}
+
+// Removes a node from the list in O(1) and frees the node resources
+// Nodes of an intrusive list are only unlinked
 void list_remove(list_t* list, list_node_t* node)
 {
     if(list == NULL || node == NULL || list->count == 0)
@@ -264,66 +386,29 @@ void list_remove(list_t* list, list_node_t* node)
         return; 
     }
 
-    list_node_t* curr_node = list->head; 
-    while(curr_node != NULL)
+    //the node's own links tell us its neighbors, so there is no need to search for it
+    if(node->prev != NULL)
     {
-        if(curr_node == node)
-        {
-            if(list_count(list) == 1)
-            {
-                list->head = NULL; 
-                list->tail = NULL; 
-                free(curr_node); 
-                list->count--; 
-                return;
-            }
-            else if(list_count(list) == 2)
-            {
-                if(curr_node == list_head(list))
-                {
-                    list->head = list_tail(list);
-
-                    list->tail->next = NULL;
-                    list->tail->prev = NULL; 
-                }
-                else
-                {
-                    list->tail = list_head(list);
-
-                    list->head->next = NULL; 
-                    list->head->prev = NULL; 
-                }
-                free(curr_node); 
-                list->count--; 
-                return;
-            }
-            else if(curr_node == list_head(list))
-            {
-                curr_node->next->prev = NULL; 
-                list->head = list_next(curr_node); 
-                free(curr_node); 
-                list->count--; 
-                return;
-            }
-            else if(curr_node == list_tail(list))
-            {
-                curr_node->prev->next = NULL; 
-                list->tail = list_prev(curr_node); 
-                free(curr_node); 
-                list->count--; 
-                return;
-            }
-            else
-            {
-                list_node_t* prev_node = curr_node->prev;
-                list_node_t* next_node = curr_node->next; 
-                prev_node->next = next_node; 
-                next_node->prev = prev_node; 
-                free(curr_node); 
-                list->count--; 
-                return;
-            }
-        }
-        curr_node = curr_node->next; 
+        node->prev->next = node->next; 
+    }
+    else
+    {
+        list->head = node->next; 
+    }
+    if(node->next != NULL)
+    {
+        node->next->prev = node->prev; 
+    }
+    else
+    {
+        list->tail = node->prev; 
+    }
+    node->next = NULL; 
+    node->prev = NULL; 
+    list->count--; 
+
+    if(!list->intrusive)
+    {
+        free_node(list, node); 
     }
 }
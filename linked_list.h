@@ -9,17 +9,36 @@
 // 1 if data1 goes after data2
 typedef int (*compare_fn)(void* data1, void* data2);
 
+// List node
+// Nodes are either allocated by list_insert or embedded in the user data itself and
+// linked with list_insert_node on an intrusive list
 typedef struct list_node {
     struct list_node* next; // next node in list
     struct list_node* prev; // prev node in list
     void* data; // generic user-specified data pointer
 } list_node_t;
 
+// Chunk of nodes carved up by a node pool
+typedef struct list_pool_chunk {
+    struct list_pool_chunk* next; // next chunk owned by the pool
+    list_node_t nodes[]; // nodes carved from this chunk
+} list_pool_chunk_t;
+
+// Slab pool of list nodes
+// Nodes are carved from large chunks and recycled through a free list on removal
+typedef struct {
+    list_node_t* free_nodes; // recycled nodes, linked through their next pointers
+    list_pool_chunk_t* chunks; // chunks allocated by the pool
+    size_t chunk_nodes; // number of nodes per chunk
+} list_pool_t;
+
 typedef struct {
     list_node_t* head; // head of the list
     list_node_t* tail; // tail of the list
     size_t count; // count of nodes in the list
     compare_fn compare; // order for inserting data; NULL indicates to insert at the head
+    int intrusive; // nonzero if nodes are owned by the user data instead of the list
+    list_pool_t* pool; // node pool owned by the list; NULL indicates nodes are malloc'd one at a time
 } list_t;
 
 void print_linked_list(list_t* list);
@@ -28,7 +47,18 @@ void print_linked_list(list_t* list);
 // If compare is NULL, list_insert just inserts at the head
 list_t* list_create(compare_fn compare);
 
+// Creates and returns a new intrusive list
+// Nodes are embedded in the user data and linked with list_insert_node, so the list
+// never allocates or frees nodes itself
+list_t* list_create_intrusive(compare_fn compare);
+
+// Creates and returns a new list that allocates its nodes from a private pool
+// Nodes are carved chunk_nodes at a time and recycled on removal
+// The pool is released by list_destroy
+list_t* list_create_pooled(compare_fn compare, size_t chunk_nodes);
+
 // Destroys a list
+// Nodes of an intrusive list are unlinked but not freed
 void list_destroy(list_t* list);
 
 // Returns head of the list
@@ -60,7 +90,12 @@ list_node_t* list_find(list_t* list, void* data);
 // Returns new node inserted
 list_node_t* list_insert(list_t* list, void* data);
 
-// Removes a node from the list and frees the node resources
+// Links a user-owned node holding the given data into an intrusive list
+// Returns the node inserted, or NULL if the list is not intrusive
+list_node_t* list_insert_node(list_t* list, list_node_t* node, void* data);
+
+// Removes a node from the list in O(1) and frees the node resources
+// Nodes of an intrusive list are only unlinked
 void list_remove(list_t* list, list_node_t* node);
 
 #endif // LINKED_LIST_H
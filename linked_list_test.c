@@ -379,6 +379,107 @@ char* test_list_remove()
     return NULL;
 }
 
+char* test_list_pooled()
+{
+    /*
+     * A pooled list behaves like a regular list
+     */
+    list_t* new_list = list_create_pooled(test_compare_function, 2);
+    mu_assert("test_list_pooled: Testing if list is not NULL", new_list != NULL);
+    data_item_t data[5];
+    int data_values[] = {4, 2, 5, 1, 3};
+    for (int i = 0; i < 5; i++) {
+        data[i].value = data_values[i];
+        list_insert(new_list, &data[i]);
+    }
+    mu_assert("test_list_pooled: List node count should be 5", list_count(new_list) == 5);
+    list_node_t* current_node = list_head(new_list);
+    for (int i = 1; i <= 5; i++) {
+        mu_assert("test_list_pooled: Testing if nodes are in sorted order", ((data_item_t*)list_data(current_node))->value == i);
+        current_node = list_next(current_node);
+    }
+
+    /*
+     * Removed nodes are recycled by later inserts
+     */
+    list_node_t* removed_node = list_head(new_list);
+    list_remove(new_list, removed_node);
+    mu_assert("test_list_pooled: List node count should be 4", list_count(new_list) == 4);
+    mu_assert("test_list_pooled: Testing if the removed node is reused", list_insert(new_list, &data[3]) == removed_node);
+    mu_assert("test_list_pooled: Testing if the reused node is at the head", list_head(new_list) == removed_node);
+    mu_assert("test_list_pooled: Testing if node has correct value, it should have 1", ((data_item_t*)list_data(list_head(new_list)))->value == 1);
+
+    // Destroying the list releases the pool along with any nodes still in use
+    list_destroy(new_list);
+
+    mu_assert("test_list_pooled: Testing if an empty chunk size is rejected", list_create_pooled(NULL, 0) == NULL);
+    return NULL;
+}
+
+typedef struct {
+    int value;
+    list_node_t node;
+} intrusive_item_t;
+
+char* test_list_intrusive()
+{
+    /*
+     * Nodes embedded in the data are linked in sorted order without allocating
+     */
+    list_t* new_list = list_create_intrusive(test_compare_function);
+    intrusive_item_t items[5];
+    int item_values[] = {3, 1, 5, 2, 4};
+    for (int i = 0; i < 5; i++) {
+        items[i].value = item_values[i];
+        mu_assert("test_list_intrusive: Testing if the embedded node is returned", list_insert_node(new_list, &items[i].node, &items[i]) == &items[i].node);
+    }
+    mu_assert("test_list_intrusive: List node count should be 5", list_count(new_list) == 5);
+    mu_assert("test_list_intrusive: Allocating inserts are rejected on an intrusive list", list_insert(new_list, &items[0]) == NULL);
+    mu_assert("test_list_intrusive: List node count should still be 5", list_count(new_list) == 5);
+
+    list_node_t* current_node = list_head(new_list);
+    for (int i = 1; i <= 5; i++) {
+        mu_assert("test_list_intrusive: Testing if nodes are in sorted order", ((intrusive_item_t*)list_data(current_node))->value == i);
+        current_node = list_next(current_node);
+    }
+
+    /*
+     * Removing through the embedded node unlinks the middle, head and tail
+     */
+    list_remove(new_list, &items[0].node); // value 3
+    mu_assert("test_list_intrusive: List node count should be 4", list_count(new_list) == 4);
+    mu_assert("test_list_intrusive: Removed node should be unlinked", items[0].node.next == NULL && items[0].node.prev == NULL);
+    list_remove(new_list, &items[1].node); // value 1, head
+    mu_assert("test_list_intrusive: Removing the head, new head should have the value 2", ((intrusive_item_t*)list_data(list_head(new_list)))->value == 2);
+    list_remove(new_list, &items[2].node); // value 5, tail
+    mu_assert("test_list_intrusive: Removing the tail, new tail should have the value 4", ((intrusive_item_t*)list_data(list_tail(new_list)))->value == 4);
+    mu_assert("test_list_intrusive: Testing if head links to tail", list_next(list_head(new_list)) == list_tail(new_list));
+    mu_assert("test_list_intrusive: Testing if tail links to head", list_prev(list_tail(new_list)) == list_head(new_list));
+
+    /*
+     * A removed node can be linked again
+     */
+    list_insert_node(new_list, &items[0].node, &items[0]);
+    current_node = list_head(new_list);
+    mu_assert("test_list_intrusive: Testing if node has correct value, it should have 2", ((intrusive_item_t*)list_data(current_node))->value == 2);
+    current_node = list_next(current_node);
+    mu_assert("test_list_intrusive: Testing if node has correct value, it should have 3", ((intrusive_item_t*)list_data(current_node))->value == 3);
+    current_node = list_next(current_node);
+    mu_assert("test_list_intrusive: Testing if node has correct value, it should have 4", ((intrusive_item_t*)list_data(current_node))->value == 4);
+    mu_assert("test_list_intrusive: Testing if node is at the tail", current_node == list_tail(new_list));
+
+    // Destroying the list leaves the embedded nodes to their owners
+    list_destroy(new_list);
+
+    /*
+     * Embedded nodes can't be linked into a list that owns its nodes
+     */
+    list_t* new_list1 = list_create(NULL);
+    mu_assert("test_list_intrusive: Embedded nodes are rejected on a regular list", list_insert_node(new_list1, &items[0].node, &items[0]) == NULL);
+    list_destroy(new_list1);
+    return NULL;
+}
+
 typedef char* (*test_fn_t)();
 typedef struct {
     char* name;
@@ -389,7 +490,9 @@ test_t tests[] = {
     {"test_list_create", test_list_create},
     {"test_list_insert", test_list_insert},
     {"test_list_find",   test_list_find},
-    {"test_list_remove", test_list_remove} 
+    {"test_list_remove", test_list_remove},
+    {"test_list_intrusive", test_list_intrusive},
+    {"test_list_pooled", test_list_pooled}
 };
  
 size_t num_tests = sizeof(tests)/sizeof(tests[0]);
@@ -1,48 +1,140 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include "trace.h"
+#include "trace_batch.h"
+
+// Every scheduler, in the order they're listed and swept
+static const char* const schedulerNames[] = { "FCFS", "LCFS", "SJF", "PLCFS", "PSJF", "SRPT", "PS", "FB" };
+#define SCHEDULER_COUNT (sizeof(schedulerNames) / sizeof(schedulerNames[0]))
 
 // Print program usage info
 void usage(char* program)
 {
-    printf("%s traceFile outFile scheduler\n", program);
+    printf("%s [-s] [-p] [-P parseThreads] [-m sortMiB] [-T tempDir] [-S [-j threads]] traceFile outFile scheduler\n", program);
+    printf("%s [-s] [-p] [-P parseThreads] [-m sortMiB] [-T tempDir] -B [-j threads] manifestFile\n", program);
+    printf("-s - stream the output in completion order instead of sorting it by job id\n");
+    printf("-p - parse the trace and write the output on their own threads\n");
+    printf("-P - threads parsing chunks of a text trace file in parallel, 0 by default to parse it serially\n");
+    printf("-m - memory for sorting the output before spilling to disk, in MiB, 0 for no limit\n");
+    printf("-T - directory for sort spill files, $TMPDIR or /tmp by default\n");
+    printf("-S - sweep a comma separated list of schedulers, or all, over a trace decoded once,\n");
+    printf("     writing each scheduler's output to outFile.SCHEDULER, so outFile can't be -\n");
+    printf("-B - run every \"traceFile outFile scheduler\" line of manifestFile and report each run's time,\n");
+    printf("     each outFile must differ and can't be -, and at most one traceFile can be -\n");
+    printf("-j - schedulers or runs to run at once in a sweep or batch, one per CPU by default\n");
+    printf("traceFile, outFile and manifestFile may be - for standard input and standard output\n");
     printf("Scheduler options:\n");
-    printf("FCFS\n");
-    printf("LCFS\n");
-    printf("SJF\n");
-    printf("PLCFS\n");
-    printf("PSJF\n");
-    printf("SRPT\n");
-    printf("PS\n");
-    printf("FB\n");
+    for (size_t i = 0; i < SCHEDULER_COUNT; i++) {
+        printf("%s\n", schedulerNames[i]);
+    }
+}
+
+// Run a sweep over the schedulers listed in the scheduler argument
+// list - comma separated schedulers or "all", split up in place
+// Returns true if every run succeeded, false otherwise
+static bool sweep(const char* traceFile, const char* outFile, char* list, const trace_options_t* options, unsigned threads)
+{
+    if (strcmp(list, "all") == 0) {
+        return traceRunSweep(traceFile, outFile, schedulerNames, SCHEDULER_COUNT, options, threads, NULL);
+    }
+    size_t count = 1;
+    for (const char* c = list; *c != '\0'; c++) {
+        count += *c == ',';
+    }
+    const char** names = malloc(count * sizeof(const char*));
+    if (names == NULL) {
+        return false;
+    }
+    count = 0;
+    for (char* name = strtok(list, ","); name != NULL; name = strtok(NULL, ",")) {
+        names[count++] = name;
+    }
+    bool ok = traceRunSweep(traceFile, outFile, names, count, options, threads, NULL);
+    free(names);
+    return ok;
+}
+
+// Run a batch of traces listed in a manifest and print the report
+// Returns true if every run succeeded, false otherwise
+static bool batch(const char* manifestFile, const trace_options_t* options, unsigned threads)
+{
+    trace_batch_t* runs = traceBatchOpen(manifestFile);
+    if (runs == NULL) {
+        return false;
+    }
+    bool ok = traceBatchRun(runs, options, threads);
+    traceBatchReport(runs, stdout);
+    traceBatchDestroy(runs);
+    return ok;
 }
 
 int main(int argc, char* argv[])
 {
-    if (argc != 4) {
+    trace_options_t options;
+    traceOptionsDefault(&options);
+    bool sweeping = false;
+    bool batching = false;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned threads = cpus > 0 ? (unsigned)cpus : 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "spP:m:T:SBj:")) != -1) {
+        switch (opt) {
+        case 's':
+            options.outputOrder = TRACE_OUTPUT_COMPLETION_ORDER;
+            break;
+        case 'p':
+            options.pipelined = true;
+            break;
+        case 'P':
+            options.parseThreads = (unsigned)strtoul(optarg, NULL, 10);
+            break;
+        case 'm':
+            options.sortMemory = (size_t)strtoull(optarg, NULL, 10) << 20;
+            break;
+        case 'T':
+            options.tempDir = optarg;
+            break;
+        case 'S':
+            sweeping = true;
+            break;
+        case 'B':
+            batching = true;
+            break;
+        case 'j':
+            threads = (unsigned)strtoul(optarg, NULL, 10);
+            break;
+        default:
+            usage(argv[0]);
+            return -1;
+        }
+    }
+    if (batching) {
+        if (sweeping || argc - optind != 1) {
+            usage(argv[0]);
+            return -1;
+        }
+        return batch(argv[optind], &options, threads) ? 0 : -2;
+    }
+    if (argc - optind != 3) {
         usage(argv[0]);
         return -1;
     }
-    // Run the trace
-    const char* traceFile = argv[1];
-    const char* outFile = argv[2];
-    const char* schedulerName = argv[3];
-    if (!traceRun(traceFile, outFile, schedulerName)) {
+    // Run the trace, the output comes out sorted by job id unless streaming was asked for
+    const char* traceFile = argv[optind];
+    const char* outFile = argv[optind + 1];
+    if (sweeping) {
+        if (!sweep(traceFile, outFile, argv[optind + 2], &options, threads)) {
+            usage(argv[0]);
+            return -2;
+        }
+        return 0;
+    }
+    const char* schedulerName = argv[optind + 2];
+    if (!traceRunStats(traceFile, outFile, schedulerName, &options, NULL)) {
         usage(argv[0]);
         return -2;
     }
-    // Sort the output file by job id
-    size_t len = 2*strlen(outFile) + strlen("sort -n -o  ") + 1;
-    char* cmd = malloc(len);
-    if (cmd == NULL) {
-        return false;
-    }
-    if (snprintf(cmd, len, "sort -n -o %s %s", outFile, outFile) != len-1) {
-        free(cmd);
-        return false;
-    }
-    int ret = system(cmd);
-    free(cmd);
-    return ret;
+    return 0;
 }
@@ -0,0 +1,505 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "completion_sort.h"
+
+#define COMPLETION_SORT_RADIX_SIZE (1 << COMPLETION_SORT_RADIX_BITS)
+#define COMPLETION_SORT_MAX_PASSES ((64 + COMPLETION_SORT_RADIX_BITS - 1) / COMPLETION_SORT_RADIX_BITS)
+#define COMPLETION_SORT_MIN_COUNT (3 * COMPLETION_SORT_MIN_RUN_BUFFER) // enough to merge two runs into a third
+
+// A run being read back during a merge
+typedef struct {
+    completion_run_t* run; // run being read
+    completion_t* buffer; // slice of the sorter's memory for this run
+    size_t bufferSize; // completions that fit in buffer
+    size_t pos; // next completion in buffer
+    size_t filled; // completions in buffer
+    uint64_t read; // completions read from the run so far
+} completion_run_reader_t;
+
+// Create a completion sorter
+// memoryBudget - bytes to use for sorting, 0 to keep every completion in memory
+// tempDir - directory for run files when the budget is exceeded
+// Returns NULL on allocation failure
+completion_sorter_t* completionSorterCreate(size_t memoryBudget, const char* tempDir)
+{
+    completion_sorter_t* sorter = malloc(sizeof(completion_sorter_t));
+    if (sorter == NULL) {
+        return NULL;
+    }
+    sorter->completions = malloc(COMPLETION_SORT_INITIAL_CAPACITY * sizeof(completion_t));
+    sorter->tempDir = strdup(tempDir);
+    if (sorter->completions == NULL || sorter->tempDir == NULL) {
+        free(sorter->completions);
+        free(sorter->tempDir);
+        free(sorter);
+        return NULL;
+    }
+    sorter->count = 0;
+    sorter->capacity = COMPLETION_SORT_INITIAL_CAPACITY;
+    sorter->maxCount = SIZE_MAX;
+    if (memoryBudget > 0) {
+        // Half the budget holds completions, the other half is scratch space for sorting them
+        sorter->maxCount = memoryBudget / 2 / sizeof(completion_t);
+        if (sorter->maxCount < COMPLETION_SORT_MIN_COUNT) {
+            sorter->maxCount = COMPLETION_SORT_MIN_COUNT;
+        }
+    }
+    sorter->numRuns = 0;
+    sorter->error = false;
+    return sorter;
+}
+
+// Close every run file
+static void completionCloseRuns(completion_sorter_t* sorter)
+{
+    for (size_t i = 0; i < sorter->numRuns; i++) {
+        close(sorter->runs[i].fd);
+    }
+    sorter->numRuns = 0;
+}
+
+// Destroy a completion sorter, removing any run files
+void completionSorterDestroy(completion_sorter_t* sorter)
+{
+    completionCloseRuns(sorter);
+    free(sorter->completions);
+    free(sorter->tempDir);
+    free(sorter);
+}
+
+// Format an integer in decimal, backwards from the end of the buffer
+// Returns the first character
+static char* completionFormat(char* end, uint64_t value)
+{
+    do {
+        *--end = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    return end;
+}
+
+// Orders completions with the same id like sort does, by the bytes of the whole line
+// The lines only differ after the shared "id, " so comparing the times as text is enough
+static int completionTextCompare(const void* data1, const void* data2)
+{
+    char buffer1[20];
+    char buffer2[20];
+    char* text1 = completionFormat(buffer1 + sizeof(buffer1), ((const completion_t*)data1)->time);
+    char* text2 = completionFormat(buffer2 + sizeof(buffer2), ((const completion_t*)data2)->time);
+    size_t size1 = (size_t)(buffer1 + sizeof(buffer1) - text1);
+    size_t size2 = (size_t)(buffer2 + sizeof(buffer2) - text2);
+    int result = memcmp(text1, text2, size1 < size2 ? size1 : size2);
+    if (result != 0) {
+        return result;
+    }
+    return (size1 > size2) - (size1 < size2);
+}
+
+// Returns true if completion1 is written before completion2
+static inline bool completionBefore(const completion_t* completion1, const completion_t* completion2)
+{
+    if (completion1->id != completion2->id) {
+        return completion1->id < completion2->id;
+    }
+    return completionTextCompare(completion1, completion2) < 0;
+}
+
+// Order completions that are already ordered by id among the ones that share an id
+static void completionSortTies(completion_t* completions, size_t count)
+{
+    size_t start = 0;
+    while (start < count) {
+        size_t end = start + 1;
+        while (end < count && completions[end].id == completions[start].id) {
+            end++;
+        }
+        if (end - start > 1) {
+            qsort(&completions[start], end - start, sizeof(completion_t), completionTextCompare);
+        }
+        start = end;
+    }
+}
+
+// Least significant digit first radix sort on id
+// Only the bits where the ids differ from the smallest are sorted, and passes where every
+// id has the same digit are skipped. The sort is stable, so repeated ids stay in completion
+// order until completionSortTies orders them.
+// completions - completions to sort
+// count - number of completions, at least 1
+// temp - scratch space for count completions
+// Returns whichever of completions and temp holds the sorted completions, or NULL on allocation failure
+static completion_t* completionRadixSort(completion_t* completions, size_t count, completion_t* temp)
+{
+    size_t (*histograms)[COMPLETION_SORT_RADIX_SIZE] = calloc(COMPLETION_SORT_MAX_PASSES, sizeof(*histograms));
+    if (histograms == NULL) {
+        return NULL;
+    }
+    uint64_t minId = completions[0].id;
+    uint64_t maxId = minId;
+    for (size_t i = 1; i < count; i++) {
+        minId = completions[i].id < minId ? completions[i].id : minId;
+        maxId = completions[i].id > maxId ? completions[i].id : maxId;
+    }
+    uint64_t range = maxId - minId;
+    int passes = 0;
+    while (passes < (int)COMPLETION_SORT_MAX_PASSES && (range >> (passes * COMPLETION_SORT_RADIX_BITS)) != 0) {
+        passes++;
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = completions[i].id - minId;
+        for (int pass = 0; pass < passes; pass++) {
+            histograms[pass][(key >> (pass * COMPLETION_SORT_RADIX_BITS)) & (COMPLETION_SORT_RADIX_SIZE - 1)]++;
+        }
+    }
+    completion_t* from = completions;
+    completion_t* to = temp;
+    for (int pass = 0; pass < passes; pass++) {
+        size_t* histogram = histograms[pass];
+        unsigned shift = (unsigned)(pass * COMPLETION_SORT_RADIX_BITS);
+        if (histogram[(from[0].id - minId) >> shift & (COMPLETION_SORT_RADIX_SIZE - 1)] == count) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t digit = 0; digit < COMPLETION_SORT_RADIX_SIZE; digit++) {
+            size_t digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+        for (size_t i = 0; i < count; i++) {
+            to[histogram[(from[i].id - minId) >> shift & (COMPLETION_SORT_RADIX_SIZE - 1)]++] = from[i];
+        }
+        completion_t* swap = from;
+        from = to;
+        to = swap;
+    }
+    free(histograms);
+    return from;
+}
+
+// Write completions through an id indexed buffer
+// Returns false if an id repeats or on allocation failure, in which case nothing is written
+static bool completionWriteDense(completion_sorter_t* sorter, uint64_t minId, uint64_t maxId, trace_writer_t* writer)
+{
+    size_t slots = (size_t)(maxId - minId) + 1;
+    uint64_t* times = malloc(slots * sizeof(uint64_t));
+    uint64_t* present = calloc((slots + 63) / 64, sizeof(uint64_t));
+    if (times == NULL || present == NULL) {
+        free(times);
+        free(present);
+        return false;
+    }
+    for (size_t i = 0; i < sorter->count; i++) {
+        size_t slot = (size_t)(sorter->completions[i].id - minId);
+        uint64_t bit = 1ULL << (slot % 64);
+        if (present[slot / 64] & bit) {
+            free(times);
+            free(present);
+            return false;
+        }
+        present[slot / 64] |= bit;
+        times[slot] = sorter->completions[i].time;
+    }
+    for (size_t word = 0; word < (slots + 63) / 64; word++) {
+        uint64_t bits = present[word];
+        while (bits != 0) {
+            size_t slot = word * 64 + (size_t)__builtin_ctzll(bits);
+            traceWriterCompletion(writer, minId + slot, times[slot]);
+            bits &= bits - 1;
+        }
+    }
+    free(times);
+    free(present);
+    return true;
+}
+
+// Write the completions held in memory when nothing was spilled
+// Returns false on allocation failure, in which case nothing is written
+static bool completionWriteMemory(completion_sorter_t* sorter, trace_writer_t* writer)
+{
+    uint64_t minId = sorter->completions[0].id;
+    uint64_t maxId = minId;
+    for (size_t i = 1; i < sorter->count; i++) {
+        uint64_t id = sorter->completions[i].id;
+        minId = id < minId ? id : minId;
+        maxId = id > maxId ? id : maxId;
+    }
+    if (maxId - minId < (uint64_t)sorter->count * COMPLETION_SORT_DENSE_FACTOR &&
+        completionWriteDense(sorter, minId, maxId, writer)) {
+        return true;
+    }
+    completion_t* temp = malloc(sorter->count * sizeof(completion_t));
+    if (temp == NULL) {
+        return false;
+    }
+    completion_t* sorted = completionRadixSort(sorter->completions, sorter->count, temp);
+    if (sorted == NULL) {
+        free(temp);
+        return false;
+    }
+    completionSortTies(sorted, sorter->count);
+    for (size_t i = 0; i < sorter->count; i++) {
+        traceWriterCompletion(writer, sorted[i].id, sorted[i].time);
+    }
+    free(temp);
+    return true;
+}
+
+// Create an empty run file in the temporary directory
+// The file is unlinked straight away so it never outlives the sorter
+// Returns the file descriptor, or -1 on failure
+static int completionCreateRunFile(completion_sorter_t* sorter)
+{
+    size_t size = strlen(sorter->tempDir) + sizeof("/completion_run.XXXXXX");
+    char* path = malloc(size);
+    if (path == NULL) {
+        return -1;
+    }
+    snprintf(path, size, "%s/completion_run.XXXXXX", sorter->tempDir);
+    int fd = mkstemp(path);
+    if (fd >= 0) {
+        unlink(path);
+    }
+    free(path);
+    return fd;
+}
+
+// Write completions to a run file
+// Returns false if the write failed
+static bool completionWriteRun(int fd, const completion_t* completions, size_t count)
+{
+    const char* data = (const char*)completions;
+    size_t size = count * sizeof(completion_t);
+    while (size > 0) {
+        ssize_t bytes = write(fd, data, size);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return false;
+        }
+        data += bytes;
+        size -= (size_t)bytes;
+    }
+    return true;
+}
+
+// Refill a run reader's buffer
+// Returns false if the run has no more completions or the read failed
+static bool completionRunReaderFill(completion_run_reader_t* reader)
+{
+    uint64_t left = reader->run->count - reader->read;
+    size_t count = left < reader->bufferSize ? (size_t)left : reader->bufferSize;
+    char* data = (char*)reader->buffer;
+    size_t size = count * sizeof(completion_t);
+    off_t offset = (off_t)(reader->read * sizeof(completion_t));
+    while (size > 0) {
+        ssize_t bytes = pread(reader->run->fd, data, size, offset);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return false;
+        }
+        data += bytes;
+        offset += bytes;
+        size -= (size_t)bytes;
+    }
+    reader->pos = 0;
+    reader->filled = count;
+    reader->read += count;
+    return count > 0;
+}
+
+// Returns true if reader1's next completion is written before reader2's
+static inline bool completionRunReaderBefore(completion_run_reader_t* reader1, completion_run_reader_t* reader2)
+{
+    return completionBefore(&reader1->buffer[reader1->pos], &reader2->buffer[reader2->pos]);
+}
+
+// Restore the heap order below a run reader
+static void completionMergeSiftDown(completion_run_reader_t** heap, size_t count, size_t index)
+{
+    while (true) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < count && completionRunReaderBefore(heap[left], heap[smallest])) {
+            smallest = left;
+        }
+        if (right < count && completionRunReaderBefore(heap[right], heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            return;
+        }
+        completion_run_reader_t* swap = heap[index];
+        heap[index] = heap[smallest];
+        heap[smallest] = swap;
+        index = smallest;
+    }
+}
+
+// Merge every run, using the sorter's completion buffer as the read and write buffers
+// The buffer must be empty. Every run is closed afterwards.
+// sorter - completion sorter
+// writer - output writer, or NULL to merge into a single new run
+// Returns false on a run file failure
+static bool completionMerge(completion_sorter_t* sorter, trace_writer_t* writer)
+{
+    completion_run_reader_t readers[COMPLETION_SORT_MAX_FAN_IN];
+    completion_run_reader_t* heap[COMPLETION_SORT_MAX_FAN_IN];
+    size_t numRuns = sorter->numRuns;
+    size_t sliceSize = sorter->capacity / (writer == NULL ? numRuns + 1 : numRuns);
+    size_t heapCount = 0;
+    for (size_t i = 0; i < numRuns; i++) {
+        readers[i].run = &sorter->runs[i];
+        readers[i].buffer = sorter->completions + i * sliceSize;
+        readers[i].bufferSize = sliceSize;
+        readers[i].read = 0;
+        if (completionRunReaderFill(&readers[i])) {
+            heap[heapCount++] = &readers[i];
+        } else if (readers[i].run->count > 0) {
+            completionCloseRuns(sorter);
+            return false;
+        }
+    }
+    for (size_t i = heapCount / 2; i-- > 0;) {
+        completionMergeSiftDown(heap, heapCount, i);
+    }
+    completion_run_t merged = {-1, 0};
+    completion_t* out = sorter->completions + numRuns * sliceSize;
+    size_t outCount = 0;
+    bool ok = true;
+    if (writer == NULL) {
+        merged.fd = completionCreateRunFile(sorter);
+        ok = merged.fd >= 0;
+    }
+    while (ok && heapCount > 0) {
+        completion_run_reader_t* reader = heap[0];
+        completion_t* completion = &reader->buffer[reader->pos++];
+        if (writer != NULL) {
+            traceWriterCompletion(writer, completion->id, completion->time);
+        } else {
+            out[outCount++] = *completion;
+            if (outCount == sliceSize) {
+                ok = completionWriteRun(merged.fd, out, outCount);
+                merged.count += outCount;
+                outCount = 0;
+            }
+        }
+        if (reader->pos == reader->filled && !completionRunReaderFill(reader)) {
+            if (reader->read != reader->run->count) {
+                ok = false;
+            }
+            heap[0] = heap[--heapCount];
+        }
+        completionMergeSiftDown(heap, heapCount, 0);
+    }
+    if (ok && outCount > 0) {
+        ok = completionWriteRun(merged.fd, out, outCount);
+        merged.count += outCount;
+    }
+    completionCloseRuns(sorter);
+    if (writer == NULL) {
+        if (!ok) {
+            if (merged.fd >= 0) {
+                close(merged.fd);
+            }
+            return false;
+        }
+        sorter->runs[sorter->numRuns++] = merged;
+    }
+    return ok;
+}
+
+// Returns the number of runs that can be merged at once in the sorter's memory
+static size_t completionFanIn(completion_sorter_t* sorter)
+{
+    // Every run being merged and the merged run's output get a slice of the buffer
+    size_t fanIn = sorter->capacity / COMPLETION_SORT_MIN_RUN_BUFFER - 1;
+    return fanIn < COMPLETION_SORT_MAX_FAN_IN ? fanIn : COMPLETION_SORT_MAX_FAN_IN;
+}
+
+// Sort the completions in memory and spill them to a new run file
+// Runs are merged into one once there are as many as can be merged at once
+// Returns false on allocation or run file failure
+static bool completionSpill(completion_sorter_t* sorter)
+{
+    completion_t* temp = malloc(sorter->count * sizeof(completion_t));
+    if (temp == NULL) {
+        return false;
+    }
+    completion_t* sorted = completionRadixSort(sorter->completions, sorter->count, temp);
+    completion_run_t run = {completionCreateRunFile(sorter), sorter->count};
+    bool ok = sorted != NULL && run.fd >= 0;
+    if (ok) {
+        completionSortTies(sorted, sorter->count);
+        ok = completionWriteRun(run.fd, sorted, sorter->count);
+    }
+    free(temp);
+    if (!ok) {
+        if (run.fd >= 0) {
+            close(run.fd);
+        }
+        return false;
+    }
+    sorter->runs[sorter->numRuns++] = run;
+    sorter->count = 0;
+    if (sorter->numRuns == completionFanIn(sorter)) {
+        return completionMerge(sorter, NULL);
+    }
+    return true;
+}
+
+// Add a completion
+// A failure is remembered and reported by completionSorterWrite
+void completionSorterAdd(completion_sorter_t* sorter, uint64_t id, uint64_t time)
+{
+    if (sorter->error) {
+        return;
+    }
+    if (sorter->count == sorter->capacity) {
+        if (sorter->capacity >= sorter->maxCount) {
+            if (!completionSpill(sorter)) {
+                sorter->error = true;
+                return;
+            }
+        } else {
+            size_t capacity = sorter->capacity < sorter->maxCount / 2 ? 2 * sorter->capacity : sorter->maxCount;
+            completion_t* completions = realloc(sorter->completions, capacity * sizeof(completion_t));
+            if (completions == NULL) {
+                sorter->error = true;
+                return;
+            }
+            sorter->completions = completions;
+            sorter->capacity = capacity;
+        }
+    }
+    sorter->completions[sorter->count].id = id;
+    sorter->completions[sorter->count].time = time;
+    sorter->count++;
+}
+
+// Write every completion ordered by id
+// sorter - completion sorter, emptied on return
+// writer - output writer
+// Returns false if a completion was lost or on allocation or run file failure
+bool completionSorterWrite(completion_sorter_t* sorter, trace_writer_t* writer)
+{
+    bool ok = !sorter->error;
+    if (ok && sorter->numRuns == 0 && sorter->count > 0) {
+        ok = completionWriteMemory(sorter, writer);
+    } else if (ok && sorter->numRuns > 0) {
+        if (sorter->count > 0) {
+            ok = completionSpill(sorter);
+        }
+        ok = ok && completionMerge(sorter, writer);
+    }
+    completionCloseRuns(sorter);
+    sorter->count = 0;
+    sorter->error = false;
+    return ok;
+}
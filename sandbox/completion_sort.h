@@ -0,0 +1,65 @@
+#ifndef COMPLETION_SORT_H
+#define COMPLETION_SORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "trace_writer.h"
+
+#define COMPLETION_SORT_INITIAL_CAPACITY 1024 // completions held before the first resize
+#define COMPLETION_SORT_RADIX_BITS 11 // id bits sorted per radix pass
+#define COMPLETION_SORT_DENSE_FACTOR 2 // ids spanning up to this many slots per completion use a dense buffer
+#define COMPLETION_SORT_MIN_RUN_BUFFER 1024 // fewest completions buffered per run while merging
+#define COMPLETION_SORT_MAX_FAN_IN 64 // most runs merged at once, each holds a file descriptor
+
+// A completed job
+typedef struct {
+    uint64_t id; // job id
+    uint64_t time; // completion time
+} completion_t;
+
+// A sorted run of completions spilled to a temporary file
+typedef struct {
+    int fd; // run file, already unlinked so it goes away when closed
+    uint64_t count; // completions in the run
+} completion_run_t;
+
+// Completion sorter
+// Collects completions and writes them ordered by job id, in the same order as "sort -n" on
+// the completion order output: by id, then for repeated ids by the text of the whole line.
+// Compact ids are placed straight into an id indexed buffer, anything else is radix sorted.
+// When a memory budget is set and the completions outgrow it, they are sorted and spilled to
+// run files in a temporary directory, then k-way merged into the output. Runs are merged
+// early whenever COMPLETION_SORT_MAX_FAN_IN of them build up, so any number of completions
+// can be sorted in the same memory.
+typedef struct {
+    completion_t* completions; // completions in the order they were added
+    size_t count; // number of completions
+    size_t capacity; // space in completions
+    size_t maxCount; // completions held in memory before spilling a run, SIZE_MAX without a budget
+    char* tempDir; // directory for run files
+    completion_run_t runs[COMPLETION_SORT_MAX_FAN_IN]; // spilled runs
+    size_t numRuns; // number of spilled runs
+    bool error; // set if a completion was lost to an allocation or run file failure
+} completion_sorter_t;
+
+// Create a completion sorter
+// memoryBudget - bytes to use for sorting, 0 to keep every completion in memory
+// tempDir - directory for run files when the budget is exceeded
+// Returns NULL on allocation failure
+completion_sorter_t* completionSorterCreate(size_t memoryBudget, const char* tempDir);
+
+// Destroy a completion sorter, removing any run files
+void completionSorterDestroy(completion_sorter_t* sorter);
+
+// Add a completion
+// A failure is remembered and reported by completionSorterWrite
+void completionSorterAdd(completion_sorter_t* sorter, uint64_t id, uint64_t time);
+
+// Write every completion ordered by id
+// sorter - completion sorter, emptied on return
+// writer - output writer
+// Returns false if a completion was lost or on allocation or run file failure
+bool completionSorterWrite(completion_sorter_t* sorter, trace_writer_t* writer);
+
+#endif /* COMPLETION_SORT_H */
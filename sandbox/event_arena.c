@@ -0,0 +1,60 @@
+#include <stdlib.h>
+#include "event_arena.h"
+
+// Creates and returns an empty event arena
+// chunkEvents - number of events carved from each chunk
+event_arena_t* eventArenaCreate(size_t chunkEvents)
+{
+    if (chunkEvents == 0) {
+        return NULL;
+    }
+    event_arena_t* arena = malloc(sizeof(event_arena_t));
+    if (arena == NULL) {
+        return NULL;
+    }
+    arena->freeSlots = NULL;
+    arena->chunks = NULL;
+    arena->chunkEvents = chunkEvents;
+    return arena;
+}
+
+// Destroys an event arena and every event allocated from it
+void eventArenaDestroy(event_arena_t* arena)
+{
+    event_chunk_t* chunk = arena->chunks;
+    while (chunk != NULL) {
+        event_chunk_t* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+// Returns an unused event, or NULL if a new chunk could not be allocated
+event_t* eventArenaAlloc(event_arena_t* arena)
+{
+    if (arena->freeSlots == NULL) {
+        event_chunk_t* chunk = malloc(sizeof(event_chunk_t) + arena->chunkEvents * sizeof(event_slot_t));
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        // Link the slots in address order so fresh events are handed out sequentially
+        for (size_t i = arena->chunkEvents; i > 0; i--) {
+            chunk->slots[i - 1].next = arena->freeSlots;
+            arena->freeSlots = &chunk->slots[i - 1];
+        }
+    }
+    event_slot_t* slot = arena->freeSlots;
+    arena->freeSlots = slot->next;
+    return &slot->event;
+}
+
+// Returns an event to the arena for reuse
+void eventArenaFree(event_arena_t* arena, event_t* event)
+{
+    event_slot_t* slot = (event_slot_t*)event;
+    slot->next = arena->freeSlots;
+    arena->freeSlots = slot;
+}
@@ -0,0 +1,42 @@
+#ifndef EVENT_ARENA_H
+#define EVENT_ARENA_H
+
+#include <stddef.h>
+#include "event.h"
+
+// Slot in an event arena chunk
+// A free slot holds the free list link in place of the event
+typedef union event_slot {
+    event_t event; // event in use
+    union event_slot* next; // next free slot
+} event_slot_t;
+
+// Chunk of event slots carved up by an event arena
+typedef struct event_chunk {
+    struct event_chunk* next; // next chunk owned by the arena
+    event_slot_t slots[]; // slots carved from this chunk
+} event_chunk_t;
+
+// Arena of fixed size events
+// Events are carved from large chunks and recycled through a free list, so a run only
+// calls the allocator when the number of pending events reaches a new high
+typedef struct {
+    event_slot_t* freeSlots; // recycled slots
+    event_chunk_t* chunks; // chunks allocated by the arena
+    size_t chunkEvents; // number of events per chunk
+} event_arena_t;
+
+// Creates and returns an empty event arena
+// chunkEvents - number of events carved from each chunk
+event_arena_t* eventArenaCreate(size_t chunkEvents);
+
+// Destroys an event arena and every event allocated from it
+void eventArenaDestroy(event_arena_t* arena);
+
+// Returns an unused event, or NULL if a new chunk could not be allocated
+event_t* eventArenaAlloc(event_arena_t* arena);
+
+// Returns an event to the arena for reuse
+void eventArenaFree(event_arena_t* arena, event_t* event);
+
+#endif /* EVENT_ARENA_H */
@@ -0,0 +1,126 @@
+#include <stdlib.h>
+#include "event_heap.h"
+
+#define EVENT_HEAP_INITIAL_CAPACITY 64
+
+// Places an event at the given slot and records the slot in the event
+static inline void eventHeapSet(event_heap_t* heap, size_t index, event_t* event)
+{
+    heap->events[index] = event;
+    event->queueIndex = index;
+}
+
+// Moves the event at index up until its parent goes before it
+static void eventHeapSiftUp(event_heap_t* heap, size_t index)
+{
+    event_t* event = heap->events[index];
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!eventBefore(event, heap->events[parent])) {
+            break;
+        }
+        eventHeapSet(heap, index, heap->events[parent]);
+        index = parent;
+    }
+    eventHeapSet(heap, index, event);
+}
+
+// Moves the event at index down until both children go after it
+static void eventHeapSiftDown(event_heap_t* heap, size_t index)
+{
+    event_t* event = heap->events[index];
+    size_t count = heap->count;
+    while (true) {
+        size_t child = 2 * index + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && eventBefore(heap->events[child + 1], heap->events[child])) {
+            child++;
+        }
+        if (!eventBefore(heap->events[child], event)) {
+            break;
+        }
+        eventHeapSet(heap, index, heap->events[child]);
+        index = child;
+    }
+    eventHeapSet(heap, index, event);
+}
+
+// Creates and returns an empty event heap
+event_heap_t* eventHeapCreate()
+{
+    event_heap_t* heap = malloc(sizeof(event_heap_t));
+    if (heap == NULL) {
+        return NULL;
+    }
+    heap->events = malloc(EVENT_HEAP_INITIAL_CAPACITY * sizeof(event_t*));
+    if (heap->events == NULL) {
+        free(heap);
+        return NULL;
+    }
+    heap->count = 0;
+    heap->capacity = EVENT_HEAP_INITIAL_CAPACITY;
+    return heap;
+}
+
+// Destroys an event heap
+// Events still in the heap are not freed
+void eventHeapDestroy(event_heap_t* heap)
+{
+    free(heap->events);
+    free(heap);
+}
+
+// Inserts an event into the heap in O(log n)
+// Returns true on success, false otherwise
+bool eventHeapPush(event_heap_t* heap, event_t* event)
+{
+    if (heap->count == heap->capacity) {
+        size_t capacity = 2 * heap->capacity;
+        event_t** events = realloc(heap->events, capacity * sizeof(event_t*));
+        if (events == NULL) {
+            return false;
+        }
+        heap->events = events;
+        heap->capacity = capacity;
+    }
+    heap->events[heap->count] = event;
+    eventHeapSiftUp(heap, heap->count++);
+    return true;
+}
+
+// Removes and returns the earliest event, or NULL if the heap is empty
+event_t* eventHeapPop(event_heap_t* heap)
+{
+    if (heap->count == 0) {
+        return NULL;
+    }
+    event_t* event = heap->events[0];
+    eventHeapRemove(heap, event);
+    return event;
+}
+
+// Removes the given event from the heap in O(log n)
+void eventHeapRemove(event_heap_t* heap, event_t* event)
+{
+    size_t index = event->queueIndex;
+    event_t* last = heap->events[--heap->count];
+    if (index == heap->count) {
+        return;
+    }
+    // Fill the hole with the last event and restore the heap order around it
+    eventHeapSet(heap, index, last);
+    eventHeapUpdate(heap, last);
+}
+
+// Restores the heap order in O(log n) after the key of the given event changed
+void eventHeapUpdate(event_heap_t* heap, event_t* event)
+{
+    size_t index = event->queueIndex;
+    if (index > 0 && eventBefore(event, heap->events[(index - 1) / 2])) {
+        eventHeapSiftUp(heap, index);
+    } else {
+        eventHeapSiftDown(heap, index);
+    }
+}
@@ -0,0 +1,157 @@
+#include <stdlib.h>
+#include "event_queue.h"
+
+// Creates and returns an empty event queue of the given type
+event_queue_t* eventQueueCreate(event_queue_type_t type)
+{
+    event_queue_t* queue = malloc(sizeof(event_queue_t));
+    if (queue == NULL) {
+        return NULL;
+    }
+    queue->type = type;
+    void* backend = NULL;
+    switch (type) {
+    case EVENT_QUEUE_HEAP:
+        backend = queue->heap = eventHeapCreate();
+        break;
+    case EVENT_QUEUE_CALENDAR:
+        backend = queue->calendar = eventCalendarCreate();
+        break;
+    case EVENT_QUEUE_LIST:
+        backend = queue->list = malloc(sizeof(event_deque_t));
+        if (queue->list != NULL) {
+            eventDequeInit(queue->list);
+        }
+        break;
+    }
+    if (backend == NULL) {
+        free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+// Destroys an event queue
+// Events still in the queue are not freed
+void eventQueueDestroy(event_queue_t* queue)
+{
+    switch (queue->type) {
+    case EVENT_QUEUE_HEAP:
+        eventHeapDestroy(queue->heap);
+        break;
+    case EVENT_QUEUE_CALENDAR:
+        eventCalendarDestroy(queue->calendar);
+        break;
+    case EVENT_QUEUE_LIST:
+        eventDequeFree(queue->list);
+        free(queue->list);
+        break;
+    }
+    free(queue);
+}
+
+// Returns the number of events in the queue
+size_t eventQueueCount(event_queue_t* queue)
+{
+    switch (queue->type) {
+    case EVENT_QUEUE_HEAP:
+        return eventHeapCount(queue->heap);
+    case EVENT_QUEUE_CALENDAR:
+        return eventCalendarCount(queue->calendar);
+    case EVENT_QUEUE_LIST:
+        return eventDequeCount(queue->list);
+    }
+    return 0;
+}
+
+// Returns the earliest event without removing it, or NULL if the queue is empty
+event_t* eventQueuePeek(event_queue_t* queue)
+{
+    switch (queue->type) {
+    case EVENT_QUEUE_HEAP:
+        return eventHeapPeek(queue->heap);
+    case EVENT_QUEUE_CALENDAR:
+        return eventCalendarPeek(queue->calendar);
+    case EVENT_QUEUE_LIST:
+        return eventDequeCount(queue->list) > 0 ? *eventDequeFront(queue->list) : NULL;
+    }
+    return NULL;
+}
+
+// Inserts an event into the queue
+// Returns true on success, false otherwise
+bool eventQueuePush(event_queue_t* queue, event_t* event)
+{
+    switch (queue->type) {
+    case EVENT_QUEUE_HEAP:
+        return eventHeapPush(queue->heap, event);
+    case EVENT_QUEUE_CALENDAR:
+        return eventCalendarPush(queue->calendar, event);
+    case EVENT_QUEUE_LIST:
+        return eventDequeInsert(queue->list, event);
+    }
+    return false;
+}
+
+// Removes and returns the earliest event, or NULL if the queue is empty
+event_t* eventQueuePop(event_queue_t* queue)
+{
+    switch (queue->type) {
+    case EVENT_QUEUE_HEAP:
+        return eventHeapPop(queue->heap);
+    case EVENT_QUEUE_CALENDAR:
+        return eventCalendarPop(queue->calendar);
+    case EVENT_QUEUE_LIST: {
+        event_t* event;
+        return eventDequePopFront(queue->list, &event) ? event : NULL;
+    }
+    }
+    return NULL;
+}
+
+// Removes the given event from the queue
+void eventQueueRemove(event_queue_t* queue, event_t* event)
+{
+    switch (queue->type) {
+    case EVENT_QUEUE_HEAP:
+        eventHeapRemove(queue->heap, event);
+        break;
+    case EVENT_QUEUE_CALENDAR:
+        eventCalendarRemove(queue->calendar, event);
+        break;
+    case EVENT_QUEUE_LIST: {
+        event_t* removed;
+        eventDequeRemove(queue->list, eventKey(event), &removed);
+        break;
+    }
+    }
+}
+
+// Moves a queued event to a new (timestamp, id) key in place
+// Returns true on success, false if the event couldn't be reinserted and has left the queue
+bool eventQueueUpdate(event_queue_t* queue, event_t* event, uint64_t timestamp, uint64_t id)
+{
+    switch (queue->type) {
+    case EVENT_QUEUE_HEAP:
+        // Decrease or increase key without leaving the heap
+        event->timestamp = timestamp;
+        event->id = id;
+        eventHeapUpdate(queue->heap, event);
+        return true;
+    case EVENT_QUEUE_CALENDAR:
+        // The key picks the bucket, so move the event into its new bucket, which may have to grow
+        eventCalendarRemove(queue->calendar, event);
+        event->timestamp = timestamp;
+        event->id = id;
+        return eventCalendarPush(queue->calendar, event);
+    case EVENT_QUEUE_LIST: {
+        // The slot already holds the event, so reinserting it can't need to grow the array
+        event_t* removed;
+        eventDequeRemove(queue->list, eventKey(event), &removed);
+        event->timestamp = timestamp;
+        event->id = id;
+        return eventDequeInsert(queue->list, event);
+    }
+    }
+    return false;
+}
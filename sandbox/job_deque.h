@@ -0,0 +1,30 @@
+#ifndef JOB_DEQUE_H
+#define JOB_DEQUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "job.h"
+#include "typed_queue.h"
+
+#define JOB_DEQUE_KEY(entry) jobGetArrivalTime(*(entry))
+
+// Double ended queue of waiting jobs in arrival order
+// Jobs arrive in time order, so an insert only compares with the back of the queue, and
+// jobs that arrive together stay in the order they were inserted
+DEFINE_SORTED_DEQUE(job_deque_t, jobDeque, job_t*, uint64_t, JOB_DEQUE_KEY)
+
+// Removes and returns the oldest job, or NULL if the deque is empty
+static inline job_t* jobDequePopOldest(job_deque_t* deque)
+{
+    job_t* job;
+    return jobDequePopFront(deque, &job) ? job : NULL;
+}
+
+// Removes and returns the newest job, or NULL if the deque is empty
+static inline job_t* jobDequePopNewest(job_deque_t* deque)
+{
+    job_t* job;
+    return jobDequePopBack(deque, &job) ? job : NULL;
+}
+
+#endif /* JOB_DEQUE_H */
@@ -0,0 +1,48 @@
+#ifndef JOB_HEAP_H
+#define JOB_HEAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "job.h"
+#include "typed_queue.h"
+
+// Scheduler's key for a job, such as its job time or remaining time, with the job id below it
+// to break ties, so jobs compare with a single integer comparison
+typedef unsigned __int128 job_key_t;
+
+// Job in a job heap with the key it was pushed with
+typedef struct {
+    job_key_t key; // key of the job
+    job_t* job; // job
+} job_heap_entry_t;
+
+#define JOB_HEAP_ENTRY_KEY(entry) ((entry)->key)
+
+// Binary min-heap of waiting jobs ordered by (key, id)
+// Keys are stored in the entries, so comparisons never touch the jobs themselves, but a job's
+// key must not change while it is in the heap. Schedulers keep the running job out of the
+// heap, which is the only job whose remaining time changes.
+DEFINE_HEAP(job_heap_t, jobHeap, job_heap_entry_t, job_key_t, JOB_HEAP_ENTRY_KEY)
+
+// Returns the key of a job with the given scheduler key
+static inline job_key_t jobHeapKey(job_t* job, uint64_t key)
+{
+    return (job_key_t)key << 64 | jobGetId(job);
+}
+
+// Inserts a job with the given scheduler key into the heap in O(log n)
+// Returns true on success, false otherwise
+static inline bool jobHeapPushJob(job_heap_t* heap, job_t* job, uint64_t key)
+{
+    job_heap_entry_t entry = { .key = jobHeapKey(job, key), .job = job };
+    return jobHeapPush(heap, entry);
+}
+
+// Removes and returns the first job in O(log n), or NULL if the heap is empty
+static inline job_t* jobHeapPopJob(job_heap_t* heap)
+{
+    job_heap_entry_t entry;
+    return jobHeapPop(heap, &entry) ? entry.job : NULL;
+}
+
+#endif /* JOB_HEAP_H */
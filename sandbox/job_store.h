@@ -0,0 +1,44 @@
+#ifndef JOB_STORE_H
+#define JOB_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "job.h"
+#include "linked_list.h"
+
+#define JOB_STORE_BLOCK_SHIFT 12 // log2 of the number of jobs per block
+#define JOB_STORE_BLOCK_JOBS ((uint32_t)1 << JOB_STORE_BLOCK_SHIFT) // number of jobs per block
+
+// Bulk storage for jobs
+// Jobs are carved from large contiguous blocks and addressed by a 32-bit index. Released
+// jobs are recycled, so memory is bounded by the number of jobs in the system at once
+// rather than by the length of the trace.
+typedef struct {
+    job_t** blocks; // blocks of JOB_STORE_BLOCK_JOBS jobs
+    size_t numBlocks; // number of allocated blocks
+    size_t blockSlots; // capacity of the blocks array
+    uint32_t count; // number of jobs carved from the blocks so far
+    list_t* freeJobs; // released jobs, linked through their intrusive nodes
+} job_store_t;
+
+// Creates and returns an empty job store
+job_store_t* jobStoreCreate();
+
+// Destroys a job store and every job allocated from it
+void jobStoreDestroy(job_store_t* store);
+
+// Creates a new job in the store
+// Returns the job, or NULL if the store is full or out of memory
+job_t* jobStoreCreateJob(job_store_t* store, uint64_t arrivalTime, uint64_t jobTime, uint64_t id);
+
+// Returns a job to the store for reuse
+// The job must not be linked into any list
+void jobStoreReleaseJob(job_store_t* store, job_t* job);
+
+// Returns the job at the given index
+static inline job_t* jobStoreGet(job_store_t* store, uint32_t index)
+{
+    return &store->blocks[index >> JOB_STORE_BLOCK_SHIFT][index & (JOB_STORE_BLOCK_JOBS - 1)];
+}
+
+#endif /* JOB_STORE_H */
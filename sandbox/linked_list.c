@@ -0,0 +1,414 @@
+#include <stdlib.h>
+#include "linked_list.h"
+
+#include <stdio.h>
+
+//Helper function to visualize linked list
+void print_linked_list(list_t* list)
+{
+    list_node_t* curr_node = list->head; 
+    printf("Current list is created, listp = %p\n", list);
+    while (curr_node != NULL)
+    {
+        if(curr_node == list->head)
+        {
+            printf("Head:   "); 
+        }
+        if(curr_node == list->tail)
+        {
+            printf("Tail:   ");
+        }
+        printf("Node:   ");
+        printf(" %p ----- Next %p ----- Prev %p   ->   DATA %p\n", curr_node, curr_node->next, curr_node->prev, curr_node->data);
+        curr_node = curr_node->next;
+    }
+    printf("\n\n");
+    
+}
+
+// Creates and returns a new list
+// If compare is NULL, list_insert just inserts at the head
+list_t* list_create(compare_fn compare)
+{
+    list_t* listp = (list_t *)malloc(sizeof(list_t)); 
+    listp->head = NULL; 
+    listp->tail = NULL; 
+    listp->count = 0; 
+    listp->compare = compare; 
+    listp->intrusive = 0; 
+    listp->pool = NULL; 
+    return listp;
+}
+
+// Creates and returns a new intrusive list
+// Nodes are embedded in the user data and linked with list_insert_node
+list_t* list_create_intrusive(compare_fn compare)
+{
+    list_t* listp = list_create(compare); 
+    if(listp != NULL)
+    {
+        listp->intrusive = 1; 
+    }
+    return listp;
+}
+
+// Creates and returns a new list that allocates its nodes from a private pool
+// Nodes are carved chunk_nodes at a time and recycled on removal
+list_t* list_create_pooled(compare_fn compare, size_t chunk_nodes)
+{
+    if(chunk_nodes == 0)
+    {
+        return NULL; 
+    }
+
+    list_pool_t* pool = malloc(sizeof(list_pool_t)); 
+    if(pool == NULL)
+    {
+        return NULL; 
+    }
+    pool->free_nodes = NULL; 
+    pool->chunks = NULL; 
+    pool->chunk_nodes = chunk_nodes; 
+
+    list_t* listp = list_create(compare); 
+    if(listp == NULL)
+    {
+        free(pool); 
+        return NULL; 
+    }
+    listp->pool = pool; 
+    return listp;
+}
+
+//Helper functions for getting nodes from and returning nodes to the list's allocator
+static list_node_t* alloc_node(list_t* list)
+{
+    list_pool_t* pool = list->pool; 
+    if(pool == NULL)
+    {
+        return malloc(sizeof(list_node_t)); 
+    }
+
+    //carve a new chunk into the free list once every recycled node is in use
+    if(pool->free_nodes == NULL)
+    {
+        list_pool_chunk_t* chunk = malloc(sizeof(list_pool_chunk_t) + pool->chunk_nodes * sizeof(list_node_t)); 
+        if(chunk == NULL)
+        {
+            return NULL; 
+        }
+        chunk->next = pool->chunks; 
+        pool->chunks = chunk; 
+        for(size_t i = 0; i < pool->chunk_nodes; i++)
+        {
+            chunk->nodes[i].next = pool->free_nodes; 
+            pool->free_nodes = &chunk->nodes[i]; 
+        }
+    }
+
+    list_node_t* node = pool->free_nodes; 
+    pool->free_nodes = node->next; 
+    return node;
+}
+
+static void free_node(list_t* list, list_node_t* node)
+{
+    list_pool_t* pool = list->pool; 
+    if(pool == NULL)
+    {
+        free(node); 
+        return; 
+    }
+    node->next = pool->free_nodes; 
+    pool->free_nodes = node; 
+}
+
+// Destroys a list
+void list_destroy(list_t* list)
+{
+    /*
+    if(list->count > 0)
+    {
+        return; 
+    }
+    */
+
+    //pooled nodes are released with their chunks below, so only other lists walk their nodes
+    list_node_t* curr_node = list->pool == NULL ? list->head : NULL; 
+    while(curr_node != NULL)
+    {
+        list_node_t* node_to_remove = curr_node; 
+        curr_node = curr_node->next; 
+        list_remove(list, node_to_remove); 
+    }
+
+    list->head = NULL; 
+    list->tail = NULL; 
+    list->count = (size_t)NULL; 
+    list->compare = NULL; 
+
+    //release every chunk of the node pool at once
+    if(list->pool != NULL)
+    {
+        list_pool_chunk_t* chunk = list->pool->chunks; 
+        while(chunk != NULL)
+        {
+            list_pool_chunk_t* chunk_to_free = chunk; 
+            chunk = chunk->next; 
+            free(chunk_to_free); 
+        }
+        free(list->pool); 
+        list->pool = NULL; 
+    }
+    free(list); 
+}
+
+// Returns head of the list
+list_node_t* list_head(list_t* list)
+{
+    if(list == NULL)
+    {
+        return NULL; 
+    }
+
+    return list->head;
+}
+
+// Returns tail of the list
+list_node_t* list_tail(list_t* list)
+{
+    if(list == NULL)
+    {
+        return NULL; 
+    }
+    return list->tail;
+}
+
+// Returns next element in the list
+list_node_t* list_next(list_node_t* node)
+{
+    if(node == NULL)
+    {
+        return NULL; 
+    }
+    return node->next;
+}
+
+// Returns prev element in the list
+list_node_t* list_prev(list_node_t* node)
+{
+    if(node == NULL)
+    {
+        return NULL; 
+    }
+    return node->prev;
+}
+
+// Returns end of the list marker
+list_node_t* list_end(list_t* list)
+{
+    if(list == NULL)
+    {
+        return NULL; 
+    }
+    return list->tail;
+}
+
+// Returns data in the given list node
+void* list_data(list_node_t* node)
+{
+    if(node == NULL)
+    {
+        return NULL; 
+    }
+    return node->data;
+}
+
+// Returns the number of elements in the list
+size_t list_count(list_t* list)
+{
+    if(list == NULL)
+    {
+        return 0; 
+    }
+    return list->count;
+}
+
+// Finds the first node in the list with the given data
+// Returns NULL if data could not be found
+list_node_t* list_find(list_t* list, void* data)
+{
+    if(list == NULL)
+    {
+        return NULL; 
+    }
+
+list_node_t* curr_node = list->head; 
+while(curr_node != NULL)
+{
+    if(curr_node->data == data)
+    {
+        return curr_node; 
+    }
+    curr_node = curr_node->next;
+}
+    return NULL;
+}
+
+//Helper funtions for inserting nodes in varying positions
+int insert_new_node_before_head(list_t* list, list_node_t* new_node)
+{
+    if(list == NULL || new_node == NULL)
+    {
+        return -1; 
+    }
+
+    new_node->next = list->head; 
+    new_node->prev = NULL; 
+    list->head->prev = new_node; 
+    list->head = new_node; 
+    list->count++; 
+    return 1;
+}
+
+int insert_new_node_after_tail(list_t* list, list_node_t* new_node)
+{
+    if(list == NULL || new_node == NULL)
+    {
+        return -1; 
+    }
+
+    new_node->next = NULL; 
+    new_node->prev = list->tail; 
+    list->tail->next = new_node; 
+    list->tail = new_node; 
+    list->count++; 
+    return 1; 
+}
+
+int insert_new_node_after_given_node(list_t* list, list_node_t* new_node, list_node_t* curr_node)
+{
+    if(list == NULL || new_node == NULL || curr_node == NULL)
+    {
+        return -1; 
+    }
+
+    new_node->next = curr_node->next; 
+    new_node->prev = curr_node; 
+    curr_node->next = new_node; 
+    new_node->next->prev = new_node; 
+    list->count++; 
+    return 1; 
+}
+
+//Links new_node into its sorted position in the list
+static list_node_t* link_new_node(list_t* list, list_node_t* new_node, void* data)
+{
+    new_node->next = NULL;
+    new_node->prev = NULL;
+    new_node->data = data; 
+
+    if(list->count == 0)
+    {
+        list->head = new_node; 
+        list->tail = new_node; 
+        list->count++;
+        return new_node; 
+    }
+
+    if(list->compare == NULL)
+    {
+        insert_new_node_before_head(list, new_node);
+        return new_node; 
+    }
+
+    /*
+    Start from tail and compare curr node with new node
+    Ensure compare funtion returns as following:
+        Return 0 if we should continue traversing up the linked list
+        Return -1 if we should place the new node after the current node
+    */
+    compare_fn compare_curr_vs_new_node = list->compare; 
+    list_node_t* curr_node = list->tail; 
+    while(curr_node != NULL)
+    {
+        int place = compare_curr_vs_new_node(curr_node->data, new_node->data); 
+        if(place == -1)
+        {
+            if(curr_node == list->tail)
+            {
+                insert_new_node_after_tail(list, new_node); 
+                return new_node; 
+            }
+            insert_new_node_after_given_node(list, new_node, curr_node); 
+            return new_node; 
+        }
+        curr_node = curr_node->prev;
+    }
+    insert_new_node_before_head(list, new_node);
+    return new_node; 
+}
+
+// Inserts a new node in the list with the given data
+// Returns new node inserted
+list_node_t* list_insert(list_t* list, void* data)
+{
+    if(list == NULL || list->intrusive)
+    {
+        return NULL; 
+    }
+
+    list_node_t* new_node = alloc_node(list); 
+    if(new_node == NULL)
+    {
+        return NULL; 
+    }
+    return link_new_node(list, new_node, data); 
+}
+
+// Links a user-owned node holding the given data into an intrusive list
+// Returns the node inserted, or NULL if the list is not intrusive
+list_node_t* list_insert_node(list_t* list, list_node_t* node, void* data)
+{
+    if(list == NULL || node == NULL || !list->intrusive)
+    {
+        return NULL; 
+    }
+    return link_new_node(list, node, data); 
+}
+
+// Removes a node from the list in O(1) and frees the node resources
+// Nodes of an intrusive list are only unlinked
+void list_remove(list_t* list, list_node_t* node)
+{
+    if(list == NULL || node == NULL || list->count == 0)
+    {
+        return; 
+    }
+
+    //the node's own links tell us its neighbors, so there is no need to search for it
+    if(node->prev != NULL)
+    {
+        node->prev->next = node->next; 
+    }
+    else
+    {
+        list->head = node->next; 
+    }
+    if(node->next != NULL)
+    {
+        node->next->prev = node->prev; 
+    }
+    else
+    {
+        list->tail = node->prev; 
+    }
+    node->next = NULL; 
+    node->prev = NULL; 
+    list->count--; 
+
+    if(!list->intrusive)
+    {
+        free_node(list, node); 
+    }
+}
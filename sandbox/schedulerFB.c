@@ -0,0 +1,259 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "job.h"
+#include "linked_list.h"
+
+#define FB_LEVELS_INITIAL_CAPACITY 64 // levels held before the first resize
+
+// Jobs with the same attained service
+// Only the lowest level runs, sharing the processor equally between its jobs. Time that
+// doesn't divide into a whole unit for every job is kept as credit, so no time is lost.
+typedef struct {
+    uint64_t attained; // service every job in the level has attained
+    uint64_t credit; // time spent on the level not yet shared out, less than count
+    uint64_t count; // jobs in the level
+    list_node_t* jobs; // pairing heap of the jobs, first to finish at the root
+} FB_level_t;
+
+// FB scheduler info
+// Levels form a stack with the lowest attained service on top. A new job has attained
+// nothing, so it joins the top level or pushes a new one, and only the top level gains
+// service, so it can only catch up with the level below it. When it does the two merge
+// into one level, at a completion event that completes no job. Each event costs O(1) level
+// operations and one pairing heap operation.
+typedef struct {
+    FB_level_t* levels; // levels, lowest attained service last
+    size_t num_levels;
+    size_t level_capacity;
+    uint64_t last_job_run_time;
+    uint64_t num_jobs;
+} scheduler_FB_t;
+
+// Jobs in a level are linked through their intrusive nodes into a pairing heap
+// A node's prev points to its first child and next to its next sibling
+
+// Returns true if the job at node1 finishes before the job at node2 in the same level
+// Jobs in a level have attained the same service, so the shorter job finishes first, ties by id
+static inline bool FB_before(list_node_t* node1, list_node_t* node2)
+{
+    job_t* job1 = list_data(node1);
+    job_t* job2 = list_data(node2);
+    if (jobGetJobTime(job1) != jobGetJobTime(job2)) {
+        return jobGetJobTime(job1) < jobGetJobTime(job2);
+    }
+    return jobGetId(job1) < jobGetId(job2);
+}
+
+// Melds two pairing heaps and returns the new root
+static list_node_t* FB_meld(list_node_t* heap1, list_node_t* heap2)
+{
+    if (heap1 == NULL) {
+        return heap2;
+    }
+    if (heap2 == NULL) {
+        return heap1;
+    }
+    if (FB_before(heap2, heap1)) {
+        list_node_t* swap = heap1;
+        heap1 = heap2;
+        heap2 = swap;
+    }
+    heap2->next = heap1->prev;
+    heap1->prev = heap2;
+    return heap1;
+}
+
+// Removes the root of a pairing heap and returns the new root
+static list_node_t* FB_pop(list_node_t* root)
+{
+    // Meld the children in pairs, then meld the pairs from last to first
+    list_node_t* child = root->prev;
+    list_node_t* pairs = NULL;
+    while (child != NULL) {
+        list_node_t* first = child;
+        list_node_t* second = first->next;
+        child = second != NULL ? second->next : NULL;
+        first->next = NULL;
+        if (second != NULL) {
+            second->next = NULL;
+        }
+        list_node_t* pair = FB_meld(first, second);
+        pair->next = pairs;
+        pairs = pair;
+    }
+    list_node_t* heap = NULL;
+    while (pairs != NULL) {
+        list_node_t* pair = pairs;
+        pairs = pair->next;
+        pair->next = NULL;
+        heap = FB_meld(heap, pair);
+    }
+    return heap;
+}
+
+// Returns the job time of the first job to finish in a level
+static inline uint64_t FB_level_min_job_time(FB_level_t* level)
+{
+    return jobGetJobTime(list_data(level->jobs));
+}
+
+// Pushes a new level with a single job on top of the stack
+// Returns false on allocation failure
+static bool FB_push_level(scheduler_FB_t* info, list_node_t* node)
+{
+    if (info->num_levels == info->level_capacity) {
+        FB_level_t* levels = realloc(info->levels, 2 * info->level_capacity * sizeof(FB_level_t));
+        if (levels == NULL) {
+            return false;
+        }
+        info->levels = levels;
+        info->level_capacity *= 2;
+    }
+    FB_level_t* level = &info->levels[info->num_levels++];
+    level->attained = 0;
+    level->credit = 0;
+    level->count = 1;
+    level->jobs = node;
+    return true;
+}
+
+// Shares the time since the last event between the jobs in the top level
+// Events are scheduled for every merge, so the top level never passes the level below it
+static void FB_advance(scheduler_FB_t* info, uint64_t currentTime)
+{
+    uint64_t elapsed = currentTime - info->last_job_run_time;
+    info->last_job_run_time = currentTime;
+    if (info->num_levels == 0) {
+        return;
+    }
+    FB_level_t* top = &info->levels[info->num_levels - 1];
+    uint64_t total = elapsed + top->credit;
+    top->attained += total / top->count;
+    top->credit = total % top->count;
+    assert(info->num_levels == 1 || top->attained <= top[-1].attained);
+}
+
+// Merges the top level into the level below it for as long as they have caught up
+// A job finishing right now completes first, since the level below may hold credit
+static void FB_merge_levels(scheduler_FB_t* info)
+{
+    while (info->num_levels >= 2) {
+        FB_level_t* top = &info->levels[info->num_levels - 1];
+        FB_level_t* below = top - 1;
+        if (top->credit != 0 || top->attained != below->attained || FB_level_min_job_time(top) == top->attained) {
+            return;
+        }
+        below->jobs = FB_meld(below->jobs, top->jobs);
+        below->count += top->count;
+        info->num_levels--;
+    }
+}
+
+// Returns the time of the next event, the top level's first completion or its merge
+static uint64_t FB_next_event_time(scheduler_FB_t* info, uint64_t currentTime)
+{
+    FB_level_t* top = &info->levels[info->num_levels - 1];
+    uint64_t next_time = currentTime + (FB_level_min_job_time(top) - top->attained) * top->count - top->credit;
+    if (info->num_levels >= 2) {
+        uint64_t merge_time = currentTime + (top[-1].attained - top->attained) * top->count - top->credit;
+        if (merge_time < next_time) {
+            next_time = merge_time;
+        }
+    }
+    return next_time;
+}
+
+// Creates and returns scheduler specific info
+void* schedulerFBCreate()
+{
+    scheduler_FB_t* info = malloc(sizeof(scheduler_FB_t));
+    if (info == NULL) {
+        return NULL;
+    }
+    info->levels = malloc(FB_LEVELS_INITIAL_CAPACITY * sizeof(FB_level_t));
+    if (info->levels == NULL) {
+        free(info);
+        return NULL;
+    }
+
+    info->num_levels = 0;
+    info->level_capacity = FB_LEVELS_INITIAL_CAPACITY;
+    info->last_job_run_time = 0;
+    info->num_jobs = 0;
+    return info;
+}
+
+// Destroys scheduler specific info
+void schedulerFBDestroy(void* schedulerInfo)
+{
+    scheduler_FB_t* info = (scheduler_FB_t*)schedulerInfo;
+
+    free(info->levels);
+    free(info);
+}
+
+// Called to schedule a new job in the queue
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// job - new job being added to the queue
+// currentTime - the current simulated time
+void schedulerFBScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
+{
+    scheduler_FB_t* info = (scheduler_FB_t*)schedulerInfo;
+    FB_advance(info, currentTime);
+
+    /*
+     * The new job has attained nothing, so it goes into a level of its own on top,
+     * and straight into the level below if that hasn't been served yet either
+     */
+    list_node_t* node = jobGetNode(job);
+    node->prev = NULL;
+    node->next = NULL;
+    node->data = job;
+    if (!FB_push_level(info, node)) {
+        // The levels in the system are untouched, so their pending event still stands
+        schedulerFail(scheduler);
+        return;
+    }
+    info->num_jobs++;
+    FB_merge_levels(info);
+
+    schedulerRescheduleNextCompletion(scheduler, FB_next_event_time(info, currentTime));
+}
+
+// Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// currentTime - the current simulated time
+// Returns the job that is being completed, or NULL when the top level only caught up
+job_t* schedulerFBCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
+{
+    scheduler_FB_t* info = (scheduler_FB_t*)schedulerInfo;
+    FB_advance(info, currentTime);
+
+    /*
+     * Complete the first job in the top level if it has finished, jobs finishing together go
+     * one per event in id order, otherwise the top level has caught up with the one below
+     */
+    FB_level_t* top = &info->levels[info->num_levels - 1];
+    job_t* completed_job = NULL;
+    if (top->credit == 0 && FB_level_min_job_time(top) == top->attained) {
+        completed_job = list_data(top->jobs);
+        top->jobs = FB_pop(top->jobs);
+        jobSetRemainingTime(completed_job, 0);
+        info->num_jobs--;
+        if (--top->count == 0) {
+            info->num_levels--;
+        }
+    }
+    FB_merge_levels(info);
+
+    if (info->num_jobs != 0) {
+        schedulerScheduleNextCompletion(scheduler, FB_next_event_time(info, currentTime));
+    }
+
+    return completed_job;
+}
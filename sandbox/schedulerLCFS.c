@@ -0,0 +1,79 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "scheduler.h"
+#include "job.h"
+#include "job_deque.h"
+
+// LCFS scheduler info
+// Waiting jobs are queued in arrival order and the newest runs next
+// The running job is kept out of the queue
+typedef struct {
+    job_deque_t LCFS_queue;
+    job_t* curr_job; 
+} scheduler_LCFS_t;
+
+// Creates and returns scheduler specific info
+void* schedulerLCFSCreate()
+{
+    scheduler_LCFS_t* info = malloc(sizeof(scheduler_LCFS_t));
+    if (info == NULL) {
+        return NULL;
+    }
+
+    jobDequeInit(&info->LCFS_queue); 
+    info->curr_job = NULL; 
+    return info;
+}
+
+// Destroys scheduler specific info
+void schedulerLCFSDestroy(void* schedulerInfo)
+{
+    scheduler_LCFS_t* info = (scheduler_LCFS_t*)schedulerInfo;
+
+    jobDequeFree(&info->LCFS_queue);
+    free(info);
+}
+
+// Called to schedule a new job in the queue
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// job - new job being added to the queue
+// currentTime - the current simulated time
+void schedulerLCFSScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
+{
+    scheduler_LCFS_t* info = (scheduler_LCFS_t*)schedulerInfo;
+
+    //if no other job is being done, start the incoming job
+    if(info->curr_job == NULL)
+    {
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(job);
+        info->curr_job = job; 
+        schedulerScheduleNextCompletion(scheduler, job_completion_time); 
+        return; 
+    }
+    if(!jobDequeInsert(&info->LCFS_queue, job))
+    {
+        schedulerFail(scheduler);
+    }
+}
+
+// Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// currentTime - the current simulated time
+// Returns the job that is being completed
+job_t* schedulerLCFSCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
+{
+    scheduler_LCFS_t* info = (scheduler_LCFS_t*)schedulerInfo;
+    job_t* completed_job = info->curr_job;  
+    
+    //start the newest waiting job, if any
+    info->curr_job = jobDequePopNewest(&info->LCFS_queue); 
+    if(info->curr_job != NULL)
+    {
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job);
+        schedulerScheduleNextCompletion(scheduler, job_completion_time); 
+    }
+    
+    return completed_job;
+}
@@ -0,0 +1,83 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "scheduler.h"
+#include "job.h"
+#include "job_deque.h"
+
+// PLCFS scheduler info
+// Preempted jobs are queued in arrival order and the newest resumes next
+// The running job is kept out of the queue
+typedef struct {
+    job_deque_t PLCFS_queue; 
+    job_t* curr_job;
+    uint64_t last_working_time; 
+} scheduler_PLCFS_t;
+
+// Creates and returns scheduler specific info
+void* schedulerPLCFSCreate()
+{
+    scheduler_PLCFS_t* info = malloc(sizeof(scheduler_PLCFS_t));
+    if (info == NULL) {
+        return NULL;
+    }
+
+    jobDequeInit(&info->PLCFS_queue);
+    info->curr_job = NULL; 
+    return info;
+}
+
+// Destroys scheduler specific info
+void schedulerPLCFSDestroy(void* schedulerInfo)
+{
+    scheduler_PLCFS_t* info = (scheduler_PLCFS_t*)schedulerInfo;
+
+    jobDequeFree(&info->PLCFS_queue);
+    free(info);
+}
+
+// Called to schedule a new job in the queue
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// job - new job being added to the queue
+// currentTime - the current simulated time
+void schedulerPLCFSScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
+{
+    scheduler_PLCFS_t* info = (scheduler_PLCFS_t*)schedulerInfo;
+
+    //the running job is preempted, its pending completion is moved to the new job below
+    if(info->curr_job != NULL){
+        jobSetRemainingTime(info->curr_job, jobGetRemainingTime(info->curr_job)-(currentTime - info->last_working_time)); 
+        info->last_working_time = currentTime; 
+        if(!jobDequeInsert(&info->PLCFS_queue, info->curr_job))
+        {
+            //the running job carries on and the incoming job is lost
+            schedulerFail(scheduler);
+            return;
+        }
+    }
+    uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
+    info->curr_job = job; 
+    info->last_working_time = currentTime; 
+    schedulerRescheduleNextCompletion(scheduler, job_completion_time);
+}
+
+// Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// currentTime - the current simulated time
+// Returns the job that is being completed
+job_t* schedulerPLCFSCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
+{
+    scheduler_PLCFS_t* info = (scheduler_PLCFS_t*)schedulerInfo;
+    job_t* completed_job = info->curr_job; 
+
+    //resume the most recently preempted job, if any
+    info->curr_job = jobDequePopNewest(&info->PLCFS_queue); 
+    if(info->curr_job != NULL)
+    {
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job); 
+        info->last_working_time = currentTime; 
+        schedulerScheduleNextCompletion(scheduler, job_completion_time);
+    }
+    return completed_job;
+}
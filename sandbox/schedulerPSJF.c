@@ -0,0 +1,103 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "scheduler.h"
+#include "job.h"
+#include "job_heap.h"
+
+// PSJF scheduler info
+// Waiting jobs are kept in a heap keyed on job time, the running job is kept out of it
+typedef struct {
+    job_heap_t PSJF_heap; 
+    job_t* curr_job; 
+    uint64_t last_working_time; 
+} scheduler_PSJF_t;
+
+// Creates and returns scheduler specific info
+void* schedulerPSJFCreate()
+{
+    scheduler_PSJF_t* info = malloc(sizeof(scheduler_PSJF_t));
+    if (info == NULL) {
+        return NULL;
+    }
+
+    jobHeapInit(&info->PSJF_heap); 
+    info->curr_job = NULL; 
+    info->last_working_time = 0; 
+    return info;
+}
+
+// Destroys scheduler specific info
+void schedulerPSJFDestroy(void* schedulerInfo)
+{
+    scheduler_PSJF_t* info = (scheduler_PSJF_t*)schedulerInfo;
+
+    jobHeapFree(&info->PSJF_heap); 
+    free(info);
+}
+
+// Called to schedule a new job in the queue
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// job - new job being added to the queue
+// currentTime - the current simulated time
+void schedulerPSJFScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
+{
+    scheduler_PSJF_t* info = (scheduler_PSJF_t*)schedulerInfo;
+    job_t* curr_job = info->curr_job; 
+
+    //if no other job is being done, start the incoming job
+    if(curr_job == NULL)
+    {
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
+        info->curr_job = job; 
+        info->last_working_time = currentTime; 
+        schedulerScheduleNextCompletion(scheduler, job_completion_time);
+        return; 
+    }
+
+    //charge the running job for the time it has run, so it is compared and queued by what is left
+    jobSetRemainingTime(curr_job, jobGetRemainingTime(curr_job) - (currentTime - info->last_working_time)); 
+    info->last_working_time = currentTime; 
+
+    //if the incoming job is shorter than the running job, it preempts it
+    if(jobHeapKey(job, jobGetJobTime(job)) < jobHeapKey(curr_job, jobGetJobTime(curr_job)))
+    {
+        if(!jobHeapPushJob(&info->PSJF_heap, curr_job, jobGetJobTime(curr_job)))
+        {
+            //the running job carries on and the incoming job is lost
+            schedulerFail(scheduler);
+            return;
+        }
+
+        //start new job, its completion replaces the preempted job's
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
+        info->curr_job = job; 
+        schedulerRescheduleNextCompletion(scheduler, job_completion_time);
+    }
+    else if(!jobHeapPushJob(&info->PSJF_heap, job, jobGetJobTime(job)))
+    {
+        schedulerFail(scheduler);
+    }
+}
+
+// Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// currentTime - the current simulated time
+// Returns the job that is being completed
+job_t* schedulerPSJFCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
+{
+    scheduler_PSJF_t* info = (scheduler_PSJF_t*)schedulerInfo;
+    job_t* completed_job = info->curr_job; 
+
+    //resume the first waiting job, if any
+    info->curr_job = jobHeapPopJob(&info->PSJF_heap); 
+    if(info->curr_job != NULL)
+    {
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job); 
+        info->last_working_time = currentTime; 
+        schedulerScheduleNextCompletion(scheduler, job_completion_time); 
+    }
+
+    return completed_job;
+}
@@ -0,0 +1,79 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "scheduler.h"
+#include "job.h"
+#include "job_heap.h"
+
+// SJF scheduler info
+// Waiting jobs are kept in a heap keyed on job time, the running job is kept out of it
+typedef struct {
+    job_heap_t SJF_heap; 
+    job_t* curr_job; 
+} scheduler_SJF_t;
+
+// Creates and returns scheduler specific info
+void* schedulerSJFCreate()
+{
+    scheduler_SJF_t* info = malloc(sizeof(scheduler_SJF_t));
+    if (info == NULL) {
+        return NULL;
+    }
+
+    jobHeapInit(&info->SJF_heap); 
+    info->curr_job = NULL; 
+    return info;
+}
+
+// Destroys scheduler specific info
+void schedulerSJFDestroy(void* schedulerInfo)
+{
+    scheduler_SJF_t* info = (scheduler_SJF_t*)schedulerInfo;
+
+    jobHeapFree(&info->SJF_heap); 
+    free(info);
+}
+
+// Called to schedule a new job in the queue
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// job - new job being added to the queue
+// currentTime - the current simulated time
+void schedulerSJFScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
+{
+    scheduler_SJF_t* info = (scheduler_SJF_t*)schedulerInfo;
+
+    //if no other job is being done, start the incoming job
+    if(info->curr_job == NULL)
+    {
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
+        info->curr_job = job; 
+        schedulerScheduleNextCompletion(scheduler, job_completion_time); 
+        return; 
+    }
+    //otherwise it waits its turn, shortest job first
+    if(!jobHeapPushJob(&info->SJF_heap, job, jobGetJobTime(job)))
+    {
+        schedulerFail(scheduler);
+    }
+}
+
+// Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
+// schedulerInfo - scheduler specific info from create function
+// scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
+// currentTime - the current simulated time
+// Returns the job that is being completed
+job_t* schedulerSJFCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
+{
+    scheduler_SJF_t* info = (scheduler_SJF_t*)schedulerInfo;
+    job_t* completed_job = info->curr_job; 
+
+    //start the shortest waiting job, if any
+    info->curr_job = jobHeapPopJob(&info->SJF_heap); 
+    if(info->curr_job != NULL)
+    {
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job); 
+        schedulerScheduleNextCompletion(scheduler, job_completion_time); 
+    }
+
+    return completed_job;
+}
@@ -0,0 +1,327 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "trace.h"
+#include "workload.h"
+
+// Scheduler throughput benchmark
+// Every scheduler is run over generated traces of increasing size and one CSV row is
+// printed per run. Each run happens in a forked child so its peak RSS can be read back
+// from wait4 without the other runs inflating it. Rows can be saved as a baseline and
+// later runs compared against it to catch throughput and memory regressions. Schedulers
+// that get slow stop before the larger traces, so their rows are missing rather than late.
+// Each trace can be run several times and the median run kept, so one slow run caused by
+// the machine rather than the code doesn't end up in a baseline or fail a comparison.
+
+#define BENCH_MEAN_JOB_TIME 8.0 // mean job time
+#define BENCH_LOAD 0.8 // offered load, so arrivals are 10 apart on average
+#define BENCH_DEFAULT_TOLERANCE 0.25 // allowed slowdown before a run counts as a regression
+#define BENCH_MIN_COMPARE_SECONDS 0.05 // shorter baseline runs are too noisy to compare
+#define BENCH_MIN_RSS_GROWTH_KB 512 // smaller peak RSS growth is allocator and stack noise, not a regression
+#define BENCH_MAX_ROWS 64 // baseline rows that can be loaded
+#define BENCH_DEFAULT_RUNS 1 // runs of each trace and scheduler, the median is kept
+#define BENCH_MAX_RUNS 99 // most runs of each trace and scheduler
+#define BENCH_SKIP_SECONDS 0.1 // runs slower than this skip the next, ten times larger trace
+
+static const char* benchSchedulers[] = {"FCFS", "LCFS", "SJF", "PLCFS", "PSJF", "SRPT", "PS", "FB"};
+static const uint64_t benchJobCounts[] = {1000, 10000, 100000, 1000000};
+
+#define BENCH_NUM_SCHEDULERS (sizeof(benchSchedulers) / sizeof(benchSchedulers[0]))
+#define BENCH_NUM_JOB_COUNTS (sizeof(benchJobCounts) / sizeof(benchJobCounts[0]))
+
+// One benchmark result, as printed and as stored in a baseline file
+typedef struct {
+    char scheduler[16]; // scheduler name
+    uint64_t jobs; // jobs in the trace
+    uint64_t events; // events dispatched
+    double seconds; // wall time of the run
+    double eventsPerSec; // events dispatched per second
+    double nsPerEvent; // wall time per event
+    long peakRssKb; // peak resident set size of the run
+} bench_row_t;
+
+// Writes a Poisson arrival trace with exponential job times
+// Returns false if the file could not be written
+static bool benchWriteTrace(const char* path, uint64_t jobs)
+{
+    workload_config_t config;
+    workloadConfigDefault(&config);
+    config.jobs = jobs;
+    config.meanSize = BENCH_MEAN_JOB_TIME;
+    config.load = BENCH_LOAD;
+    workload_t* workload = workloadCreate(&config);
+    if (workload == NULL) {
+        return false;
+    }
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        workloadDestroy(workload);
+        return false;
+    }
+    uint64_t id;
+    uint64_t arrivalTime;
+    uint64_t jobTime;
+    while (workloadNext(workload, &id, &arrivalTime, &jobTime)) {
+        fprintf(file, "%" PRIu64 ", %" PRIu64 ", %" PRIu64 "\n", id, arrivalTime, jobTime);
+    }
+    workloadDestroy(workload);
+    return fclose(file) == 0;
+}
+
+// Returns the elapsed time in seconds between two timestamps
+static double benchSeconds(struct timespec* start, struct timespec* end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// Runs one trace in a forked child and fills in the row
+// Returns false if the run failed
+static bool benchRun(const char* traceFilename, const char* schedulerName, bench_row_t* row)
+{
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        struct timespec start;
+        struct timespec end;
+        trace_options_t options;
+        trace_stats_t stats;
+        // The output is thrown away, so sorting it would only measure the sort
+        traceOptionsDefault(&options);
+        options.outputOrder = TRACE_OUTPUT_COMPLETION_ORDER;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bool ok = traceRunStats(traceFilename, "/dev/null", schedulerName, &options, &stats);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        row->jobs = stats.jobs;
+        row->events = stats.events;
+        row->seconds = benchSeconds(&start, &end);
+        if (!ok || write(fds[1], row, sizeof(*row)) != sizeof(*row)) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+    close(fds[1]);
+    ssize_t bytes = read(fds[0], row, sizeof(*row));
+    close(fds[0]);
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0 || bytes != sizeof(*row)) {
+        return false;
+    }
+    snprintf(row->scheduler, sizeof(row->scheduler), "%s", schedulerName);
+    row->eventsPerSec = row->seconds > 0 ? (double)row->events / row->seconds : 0;
+    row->nsPerEvent = row->events > 0 ? row->seconds * 1e9 / (double)row->events : 0;
+    row->peakRssKb = usage.ru_maxrss;
+    return true;
+}
+
+// Orders rows by time per event
+static int benchCompareNsPerEvent(const void* a, const void* b)
+{
+    const bench_row_t* rowA = a;
+    const bench_row_t* rowB = b;
+    return (rowA->nsPerEvent > rowB->nsPerEvent) - (rowA->nsPerEvent < rowB->nsPerEvent);
+}
+
+// Runs one trace several times and fills in the row with the median run by time per event
+// runs - times to run the trace, at most BENCH_MAX_RUNS
+// Returns false if any run failed
+static bool benchRunMedian(const char* traceFilename, const char* schedulerName, int runs, bench_row_t* row)
+{
+    bench_row_t rows[BENCH_MAX_RUNS];
+    for (int i = 0; i < runs; i++) {
+        if (!benchRun(traceFilename, schedulerName, &rows[i])) {
+            return false;
+        }
+    }
+    qsort(rows, (size_t)runs, sizeof(bench_row_t), benchCompareNsPerEvent);
+    *row = rows[runs / 2];
+    return true;
+}
+
+// Prints a CSV row
+static void benchPrintRow(FILE* file, bench_row_t* row)
+{
+    fprintf(file, "%s, %" PRIu64 ", %" PRIu64 ", %.4f, %.0f, %.1f, %ld\n", row->scheduler, row->jobs, row->events, row->seconds, row->eventsPerSec, row->nsPerEvent, row->peakRssKb);
+}
+
+// Loads rows from a baseline file written with -w
+// Returns the number of rows loaded, or -1 if the file could not be read
+static int benchLoadBaseline(const char* path, bench_row_t* rows, int maxRows)
+{
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+    char line[256];
+    int count = 0;
+    while (count < maxRows && fgets(line, sizeof(line), file) != NULL) {
+        bench_row_t* row = &rows[count];
+        if (sscanf(line, "%15[^,], %" SCNu64 ", %" SCNu64 ", %lf, %lf, %lf, %ld", row->scheduler, &row->jobs, &row->events, &row->seconds, &row->eventsPerSec, &row->nsPerEvent, &row->peakRssKb) == 7) {
+            count++;
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+// Compares a run against its baseline row and reports any regression on stderr
+// Returns false if the run regressed
+static bool benchCompare(bench_row_t* row, bench_row_t* baseline, int numBaseline, double tolerance)
+{
+    for (int i = 0; i < numBaseline; i++) {
+        bench_row_t* base = &baseline[i];
+        if (strcmp(base->scheduler, row->scheduler) != 0 || base->jobs != row->jobs) {
+            continue;
+        }
+        bool ok = true;
+        if (base->events != row->events) {
+            fprintf(stderr, "%s %" PRIu64 ": dispatched %" PRIu64 " events, baseline %" PRIu64 "\n", row->scheduler, row->jobs, row->events, base->events);
+            ok = false;
+        }
+        if (base->seconds >= BENCH_MIN_COMPARE_SECONDS && row->nsPerEvent > base->nsPerEvent * (1 + tolerance)) {
+            fprintf(stderr, "%s %" PRIu64 ": %.1f ns/event, baseline %.1f\n", row->scheduler, row->jobs, row->nsPerEvent, base->nsPerEvent);
+            ok = false;
+        }
+        if (row->peakRssKb - base->peakRssKb >= BENCH_MIN_RSS_GROWTH_KB && (double)row->peakRssKb > (double)base->peakRssKb * (1 + tolerance)) {
+            fprintf(stderr, "%s %" PRIu64 ": peak RSS %ld KB, baseline %ld KB\n", row->scheduler, row->jobs, row->peakRssKb, base->peakRssKb);
+            ok = false;
+        }
+        return ok;
+    }
+    return true;
+}
+
+// Print program usage info
+static void usage(char* program)
+{
+    printf("%s [-n maxJobs] [-s scheduler] [-r runs] [-b baselineFile] [-w baselineFile] [-t tolerance]\n", program);
+    printf("-n - largest trace to run, in jobs\n");
+    printf("-s - only run this scheduler\n");
+    printf("-r - run each trace this many times and keep the median run, %d by default, at most %d\n", BENCH_DEFAULT_RUNS, BENCH_MAX_RUNS);
+    printf("-b - compare against a baseline and fail on regressions\n");
+    printf("-w - write the results as a new baseline\n");
+    printf("-t - allowed slowdown or growth over the baseline, %.2f by default\n", BENCH_DEFAULT_TOLERANCE);
+}
+
+int main(int argc, char* argv[])
+{
+    uint64_t maxJobs = benchJobCounts[BENCH_NUM_JOB_COUNTS - 1];
+    const char* onlyScheduler = NULL;
+    const char* baselineFilename = NULL;
+    const char* writeFilename = NULL;
+    double tolerance = BENCH_DEFAULT_TOLERANCE;
+    int runs = BENCH_DEFAULT_RUNS;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:r:b:w:t:")) != -1) {
+        switch (opt) {
+        case 'n':
+            maxJobs = strtoull(optarg, NULL, 10);
+            break;
+        case 's':
+            onlyScheduler = optarg;
+            break;
+        case 'r':
+            runs = atoi(optarg);
+            break;
+        case 'b':
+            baselineFilename = optarg;
+            break;
+        case 'w':
+            writeFilename = optarg;
+            break;
+        case 't':
+            tolerance = strtod(optarg, NULL);
+            break;
+        default:
+            usage(argv[0]);
+            return -1;
+        }
+    }
+    if (optind != argc || runs < 1 || runs > BENCH_MAX_RUNS) {
+        usage(argv[0]);
+        return -1;
+    }
+
+    bench_row_t baseline[BENCH_MAX_ROWS];
+    int numBaseline = 0;
+    if (baselineFilename != NULL) {
+        numBaseline = benchLoadBaseline(baselineFilename, baseline, BENCH_MAX_ROWS);
+        if (numBaseline < 0) {
+            fprintf(stderr, "Invalid baseline file: %s\n", baselineFilename);
+            return -1;
+        }
+    }
+    FILE* writeFile = NULL;
+    if (writeFilename != NULL) {
+        writeFile = fopen(writeFilename, "w");
+        if (writeFile == NULL) {
+            fprintf(stderr, "Invalid baseline file: %s\n", writeFilename);
+            return -1;
+        }
+    }
+
+    char dir[] = "/tmp/scheduler_bench.XXXXXX";
+    if (mkdtemp(dir) == NULL) {
+        fprintf(stderr, "Could not create a temporary directory\n");
+        return -2;
+    }
+    const char* header = "scheduler, jobs, events, seconds, events_per_sec, ns_per_event, peak_rss_kb\n";
+    printf("%s", header);
+    if (writeFile != NULL) {
+        fprintf(writeFile, "%s", header);
+    }
+    bool skip[BENCH_NUM_SCHEDULERS] = {false};
+    int ret = 0;
+    for (size_t i = 0; i < BENCH_NUM_JOB_COUNTS && benchJobCounts[i] <= maxJobs && ret >= 0; i++) {
+        char traceFilename[64];
+        snprintf(traceFilename, sizeof(traceFilename), "%s/trace_%" PRIu64 ".txt", dir, benchJobCounts[i]);
+        if (!benchWriteTrace(traceFilename, benchJobCounts[i])) {
+            fprintf(stderr, "Could not write trace: %s\n", traceFilename);
+            ret = -2;
+            break;
+        }
+        for (size_t j = 0; j < BENCH_NUM_SCHEDULERS; j++) {
+            if (skip[j] || (onlyScheduler != NULL && strcmp(onlyScheduler, benchSchedulers[j]) != 0)) {
+                continue;
+            }
+            bench_row_t row;
+            if (!benchRunMedian(traceFilename, benchSchedulers[j], runs, &row)) {
+                fprintf(stderr, "%s failed on %s\n", benchSchedulers[j], traceFilename);
+                ret = -2;
+                break;
+            }
+            // Keeps the schedulers that scale worse than linearly from dominating the run
+            skip[j] = row.seconds > BENCH_SKIP_SECONDS;
+            benchPrintRow(stdout, &row);
+            fflush(stdout);
+            if (writeFile != NULL) {
+                benchPrintRow(writeFile, &row);
+            }
+            if (!benchCompare(&row, baseline, numBaseline, tolerance)) {
+                ret = 1;
+            }
+        }
+        remove(traceFilename);
+    }
+    rmdir(dir);
+    if (writeFile != NULL && fclose(writeFile) != 0) {
+        ret = -2;
+    }
+    return ret;
+}
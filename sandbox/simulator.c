@@ -0,0 +1,161 @@
+#include <assert.h>
+#include <stdlib.h>
+#include "simulator.h"
+
+#define SIMULATOR_ARENA_CHUNK 1024 // events carved per arena chunk
+
+// Create a discrete event simulator
+// queueType - event queue backend
+simulator_t* simulatorCreate(event_queue_type_t queueType)
+{
+    simulator_t* sim = malloc(sizeof(simulator_t));
+    if (sim == NULL) {
+        return NULL;
+    }
+    sim->queue = eventQueueCreate(queueType);
+    sim->simTime = 0;
+    sim->id = 0;
+    sim->eventCount = 0;
+    if (sim->queue == NULL) {
+        free(sim);
+        return NULL;
+    }
+    sim->arrivals = list_create_intrusive(NULL);
+    sim->lastArrivalTime = 0;
+    if (sim->arrivals == NULL) {
+        eventQueueDestroy(sim->queue);
+        free(sim);
+        return NULL;
+    }
+    sim->arena = eventArenaCreate(SIMULATOR_ARENA_CHUNK);
+    if (sim->arena == NULL) {
+        list_destroy(sim->arrivals);
+        eventQueueDestroy(sim->queue);
+        free(sim);
+        return NULL;
+    }
+    return sim;
+}
+
+// Destroy a discrete event simulator
+void simulatorDestroy(simulator_t* sim)
+{
+    while (eventQueueCount(sim->queue) > 0) {
+        simulatorRemoveEvent(sim, eventQueuePeek(sim->queue));
+    }
+    while (list_count(sim->arrivals) > 0) {
+        simulatorRemoveEvent(sim, (event_t*)list_data(list_tail(sim->arrivals)));
+    }
+    eventQueueDestroy(sim->queue);
+    list_destroy(sim->arrivals);
+    eventArenaDestroy(sim->arena);
+    free(sim);
+}
+
+// Add an event to the event queue
+// sim - simulator
+// timestamp - time of the event
+// type - type of event
+// callback - function to call at the time of the event
+// callbackData - data to pass to the callback
+// Returns an event reference that can be used to remove the event
+event_t* simulatorSchedule(simulator_t* sim, uint64_t timestamp, event_type_t type, event_callback callback, void* callbackData)
+{
+    assert(timestamp >= simulatorSimTime(sim)); // ensure we don't go back in time
+    event_t* event = eventArenaAlloc(sim->arena);
+    if (event == NULL) {
+        return NULL;
+    }
+    event->timestamp = timestamp;
+    event->type = type;
+    event->id = sim->id++;
+    event->callback = callback;
+    event->callbackData = callbackData;
+    event->arrivalStream = false;
+    if (!eventQueuePush(sim->queue, event)) {
+        eventArenaFree(sim->arena, event);
+        return NULL;
+    }
+    return event;
+}
+
+// Add an arrival to the arrival stream in O(1)
+// sim - simulator
+// timestamp - time of the arrival, no earlier than the previous arrival
+// callback - function to call at the time of the arrival
+// callbackData - data to pass to the callback
+// Returns an event reference that can be used to remove the arrival
+event_t* simulatorScheduleArrival(simulator_t* sim, uint64_t timestamp, event_callback callback, void* callbackData)
+{
+    assert(timestamp >= simulatorSimTime(sim)); // ensure we don't go back in time
+    assert(list_count(sim->arrivals) == 0 || timestamp >= sim->lastArrivalTime); // ensure the stream stays sorted
+    event_t* event = eventArenaAlloc(sim->arena);
+    if (event == NULL) {
+        return NULL;
+    }
+    event->timestamp = timestamp;
+    event->type = EVENT_ARRIVAL;
+    event->id = sim->id++;
+    event->callback = callback;
+    event->callbackData = callbackData;
+    event->arrivalStream = true;
+    // Ids only grow, so inserting at the head keeps the stream in (time, type, id) order
+    list_insert_node(sim->arrivals, &event->queueNode, event);
+    sim->lastArrivalTime = timestamp;
+    return event;
+}
+
+// Remove an event from the event queue or arrival stream
+// sim - simulator
+// eventRef - reference to the event to remove, which is returned from simulatorSchedule
+void simulatorRemoveEvent(simulator_t* sim, event_t* eventRef)
+{
+    if (eventRef->arrivalStream) {
+        list_remove(sim->arrivals, &eventRef->queueNode);
+    } else {
+        eventQueueRemove(sim->queue, eventRef);
+    }
+    eventArenaFree(sim->arena, eventRef);
+}
+
+// Move a pending event to a new time in place
+// Arrival stream events can't be moved since the stream must stay in time order
+// sim - simulator
+// eventRef - reference to the event to move, which is returned from simulatorSchedule
+// timestamp - new time of the event
+// Returns true on success, false if the event couldn't be moved and has been removed
+bool simulatorReschedule(simulator_t* sim, event_t* eventRef, uint64_t timestamp)
+{
+    assert(timestamp >= simulatorSimTime(sim)); // ensure we don't go back in time
+    assert(!eventRef->arrivalStream);
+    // A fresh id keeps ties ordered exactly as a remove followed by a schedule would
+    if (!eventQueueUpdate(sim->queue, eventRef, timestamp, sim->id++)) {
+        eventArenaFree(sim->arena, eventRef);
+        return false;
+    }
+    return true;
+}
+
+// Run simulation until no more events
+void simulatorRun(simulator_t* sim)
+{
+    while (true) {
+        // Merge the oldest arrival with the earliest queued event
+        event_t* arrival = (event_t*)list_data(list_tail(sim->arrivals));
+        event_t* next = eventQueuePeek(sim->queue);
+        event_t* event;
+        // Pop before invoking the callback so it is free to schedule or remove other events
+        if (arrival != NULL && (next == NULL || eventBefore(arrival, next))) {
+            list_remove(sim->arrivals, &arrival->queueNode);
+            event = arrival;
+        } else if (next != NULL) {
+            event = eventQueuePop(sim->queue);
+        } else {
+            break;
+        }
+        sim->simTime = event->timestamp;
+        sim->eventCount++;
+        event->callback(event->callbackData);
+        eventArenaFree(sim->arena, event);
+    }
+}
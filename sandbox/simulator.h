@@ -0,0 +1,75 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <stdint.h>
+#include "event.h"
+#include "event_queue.h"
+#include "event_arena.h"
+
+typedef struct {
+    event_queue_t* queue; // event queue ordered by (time, type, id)
+    list_t* arrivals; // arrival stream in time order, oldest at the tail
+    uint64_t lastArrivalTime; // time of the newest event in the arrival stream
+    event_arena_t* arena; // storage for the events in the queue and arrival stream
+    uint64_t simTime; // simulator current time
+    uint64_t id; // current event id
+    uint64_t eventCount; // events dispatched so far
+} simulator_t;
+
+// Gets simulator time
+static inline uint64_t simulatorSimTime(simulator_t* sim)
+{
+    return sim->simTime;
+}
+
+// Gets the number of events dispatched so far
+static inline uint64_t simulatorEventCount(simulator_t* sim)
+{
+    return sim->eventCount;
+}
+
+// Create and return a discrete event simulator
+// queueType - event queue backend, EVENT_QUEUE_HEAP unless the trace suits another backend
+simulator_t* simulatorCreate(event_queue_type_t queueType);
+
+// Destroy a discrete event simulator
+void simulatorDestroy(simulator_t* sim);
+
+// Add an event to the event queue
+// sim - simulator
+// timestamp - time of the event
+// type - type of event
+// callback - function to call at the time of the event
+// callbackData - data to pass to the callback
+// Returns an event reference that can be used to remove the event
+event_t* simulatorSchedule(simulator_t* sim, uint64_t timestamp, event_type_t type, event_callback callback, void* callbackData);
+
+// Add an arrival to the arrival stream in O(1)
+// Arrivals must be added in time order, so they never need the event queue. They are
+// merged with the event queue at dispatch time in the same (time, type, id) order.
+// sim - simulator
+// timestamp - time of the arrival, no earlier than the previous arrival
+// callback - function to call at the time of the arrival
+// callbackData - data to pass to the callback
+// Returns an event reference that can be used to remove the arrival
+event_t* simulatorScheduleArrival(simulator_t* sim, uint64_t timestamp, event_callback callback, void* callbackData);
+
+// Remove an event from the event queue or arrival stream
+// sim - simulator
+// eventRef - reference to the event to remove, which is returned from simulatorSchedule
+void simulatorRemoveEvent(simulator_t* sim, event_t* eventRef);
+
+// Move a pending event to a new time in place
+// Only events from simulatorSchedule can be moved, arrival stream events stay in time order
+// The event is ordered as if it had been removed and scheduled again, but it keeps its
+// storage and reference, so this costs a single queue update
+// sim - simulator
+// eventRef - reference to the event to move, which is returned from simulatorSchedule
+// timestamp - new time of the event
+// Returns true on success, false if the event couldn't be moved and has been removed
+bool simulatorReschedule(simulator_t* sim, event_t* eventRef, uint64_t timestamp);
+
+// Run simulation until no more events
+void simulatorRun(simulator_t* sim);
+
+#endif /* SIMULATOR_H */
@@ -0,0 +1,63 @@
+#ifndef TRACE_BATCH_H
+#define TRACE_BATCH_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "trace.h"
+
+#define TRACE_BATCH_INITIAL_CAPACITY 64 // runs held before the first resize while reading a manifest
+#define TRACE_BATCH_STDIN "-" // manifest filename that reads standard input
+#define TRACE_BATCH_STDOUT "-" // output filename a manifest can't use, the report goes to standard output
+
+// Batch of trace runs read from a manifest
+// Each line of the manifest is a run, "traceFile outFile scheduler" as on the simulator
+// command line. Blank lines and lines starting with # are skipped. Runs are handed out to
+// the worker threads in manifest order, each with its own simulator, scheduler and jobs,
+// and the report lists them in manifest order whatever order they finished in. So that
+// runs can't interfere, no two lines may write the same output file, and at most one line
+// may read standard input, none if the manifest itself came from it.
+
+// One run listed in a manifest
+typedef struct {
+    char* traceFilename; // path to trace file, "-" for standard input on at most one line
+    char* outFilename; // path to output file, never standard output or another run's output
+    char* schedulerName; // queue scheduler to evaluate
+    size_t line; // manifest line the run came from
+    bool ok; // run succeeded
+    trace_stats_t stats; // counters for the run, valid when ok
+    double seconds; // wall clock time taken by the run
+} trace_batch_run_t;
+
+typedef struct {
+    trace_batch_run_t* runs; // runs in manifest order
+    size_t count; // number of runs
+    size_t capacity; // space in runs
+    const trace_options_t* options; // settings for each run while running
+    _Atomic size_t next; // next run for a worker to take
+} trace_batch_t;
+
+// Read a manifest
+// manifestFilename - path to manifest file, or TRACE_BATCH_STDIN
+// Returns NULL if the file can't be read, a line is malformed, writes to TRACE_BATCH_STDOUT or
+// another line's output file, reads standard input when it's already taken, or on allocation
+// failure
+trace_batch_t* traceBatchOpen(const char* manifestFilename);
+
+// Destroy a batch
+void traceBatchDestroy(trace_batch_t* batch);
+
+// Run every run in a batch
+// batch - batch to run, each run's results are filled in
+// options - settings for each run, NULL for the defaults
+// threads - most runs at once, the calling thread counts as one
+// Returns true if every run succeeded, false otherwise
+bool traceBatchRun(trace_batch_t* batch, const trace_options_t* options, unsigned threads);
+
+// Write a CSV report of a batch that has been run, one row per run in manifest order
+// batch - batch that has been run
+// file - file to write the report to
+void traceBatchReport(const trace_batch_t* batch, FILE* file);
+
+#endif /* TRACE_BATCH_H */
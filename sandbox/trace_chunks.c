@@ -0,0 +1,244 @@
+#include <stdlib.h>
+#include <string.h>
+#include "trace_chunks.h"
+
+// Returns where a chunk starts, just after the first newline at or after its nominal start
+// The start of chunk chunkCount is the end of the text
+static const char* traceChunksBoundary(trace_chunks_t* chunks, size_t index)
+{
+    if (index == 0) {
+        return chunks->begin;
+    }
+    if (index == chunks->chunkCount) {
+        return chunks->end;
+    }
+    const char* nominal = chunks->begin + index * TRACE_CHUNK_SIZE;
+    const char* newline = memchr(nominal - 1, '\n', (size_t)(chunks->end - (nominal - 1)));
+    return newline != NULL ? newline + 1 : chunks->end;
+}
+
+// Returns true if the text holds only whitespace
+static bool traceChunksBlank(const char* pos, const char* end)
+{
+    for (; pos < end; pos++) {
+        if (*pos != ' ' && (*pos < '\t' || *pos > '\r')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parse a chunk into a slot
+// chunks - parser
+// index - chunk to parse
+// chunk - slot to parse it into
+static void traceChunksParse(trace_chunks_t* chunks, size_t index, trace_chunk_t* chunk)
+{
+    const char* start = traceChunksBoundary(chunks, index);
+    const char* end = traceChunksBoundary(chunks, index + 1);
+    trace_reader_t reader;
+    traceReaderInitMemory(&reader, start, (size_t)(end - start));
+    chunk->count = 0;
+    chunk->stop = reader.pos;
+    trace_record_t record;
+    while (traceReaderNext(&reader, &record.id, &record.time, &record.jobTime)) {
+        if (chunk->count == chunk->capacity) {
+            trace_record_t* records = realloc(chunk->records, 2 * chunk->capacity * sizeof(trace_record_t));
+            if (records == NULL) {
+                // The serial reader picks up from this record instead
+                chunk->status = TRACE_CHUNK_SPLIT;
+                return;
+            }
+            chunk->records = records;
+            chunk->capacity *= 2;
+        }
+        chunk->records[chunk->count++] = record;
+        chunk->stop = reader.pos;
+    }
+    if (!traceReaderEof(&reader)) {
+        chunk->status = TRACE_CHUNK_MALFORMED;
+    } else if (index + 1 == chunks->chunkCount || traceChunksBlank(chunk->stop, end)) {
+        chunk->status = TRACE_CHUNK_CLEAN;
+    } else {
+        chunk->status = TRACE_CHUNK_SPLIT;
+    }
+}
+
+// Worker thread, parses chunks in order while there are free slots
+// c - parser
+static void* traceChunksThread(void* c)
+{
+    trace_chunks_t* chunks = (trace_chunks_t*)c;
+    pthread_mutex_lock(&chunks->lock);
+    while (!chunks->stopping && chunks->nextChunk < chunks->chunkCount) {
+        size_t index = chunks->nextChunk;
+        // Chunk index reuses the slot of chunk index - slotCount, which must have been read
+        if (index >= chunks->consumed + chunks->slotCount) {
+            pthread_cond_wait(&chunks->freeCond, &chunks->lock);
+            continue;
+        }
+        chunks->nextChunk++;
+        trace_chunk_t* chunk = &chunks->slots[index % chunks->slotCount];
+        pthread_mutex_unlock(&chunks->lock);
+        traceChunksParse(chunks, index, chunk);
+        pthread_mutex_lock(&chunks->lock);
+        chunk->ready = true;
+        pthread_cond_broadcast(&chunks->readyCond);
+    }
+    pthread_mutex_unlock(&chunks->lock);
+    return NULL;
+}
+
+// Start parsing a trace on worker threads
+// reader - open trace reader, must stay open until the parser is destroyed
+// threads - workers to parse with
+// Returns NULL if the trace isn't a memory mapped text trace, on allocation failure or if
+// no worker can be started, in which case the reader is left for a serial parse
+trace_chunks_t* traceChunksCreate(trace_reader_t* reader, unsigned threads)
+{
+    if (reader->map == NULL || reader->binary || threads == 0) {
+        return NULL;
+    }
+    trace_chunks_t* chunks = malloc(sizeof(trace_chunks_t));
+    if (chunks == NULL) {
+        return NULL;
+    }
+    chunks->begin = reader->pos;
+    chunks->end = reader->end;
+    size_t size = (size_t)(chunks->end - chunks->begin);
+    chunks->chunkCount = size > 0 ? (size + TRACE_CHUNK_SIZE - 1) / TRACE_CHUNK_SIZE : 1;
+    chunks->slotCount = (size_t)threads * TRACE_CHUNK_SLOTS_PER_THREAD;
+    chunks->nextChunk = 0;
+    chunks->consumed = 0;
+    chunks->stopping = false;
+    chunks->threadCount = 0;
+    chunks->current = NULL;
+    chunks->position = 0;
+    chunks->serial = false;
+    chunks->done = false;
+    chunks->eof = false;
+    chunks->slots = calloc(chunks->slotCount, sizeof(trace_chunk_t));
+    chunks->threads = malloc(threads * sizeof(pthread_t));
+    if (chunks->slots == NULL || chunks->threads == NULL) {
+        free(chunks->slots);
+        free(chunks->threads);
+        free(chunks);
+        return NULL;
+    }
+    pthread_mutex_init(&chunks->lock, NULL);
+    pthread_cond_init(&chunks->readyCond, NULL);
+    pthread_cond_init(&chunks->freeCond, NULL);
+    for (size_t i = 0; i < chunks->slotCount; i++) {
+        chunks->slots[i].capacity = TRACE_CHUNK_INITIAL_CAPACITY;
+        chunks->slots[i].records = malloc(TRACE_CHUNK_INITIAL_CAPACITY * sizeof(trace_record_t));
+        if (chunks->slots[i].records == NULL) {
+            traceChunksDestroy(chunks);
+            return NULL;
+        }
+    }
+    // A worker that fails to start just leaves more chunks for the others
+    while (chunks->threadCount < threads && pthread_create(&chunks->threads[chunks->threadCount], NULL, traceChunksThread, chunks) == 0) {
+        chunks->threadCount++;
+    }
+    if (chunks->threadCount == 0) {
+        traceChunksDestroy(chunks);
+        return NULL;
+    }
+    return chunks;
+}
+
+// Stop the workers and destroy the parser
+void traceChunksDestroy(trace_chunks_t* chunks)
+{
+    pthread_mutex_lock(&chunks->lock);
+    chunks->stopping = true;
+    pthread_cond_broadcast(&chunks->freeCond);
+    pthread_mutex_unlock(&chunks->lock);
+    for (size_t i = 0; i < chunks->threadCount; i++) {
+        pthread_join(chunks->threads[i], NULL);
+    }
+    for (size_t i = 0; i < chunks->slotCount; i++) {
+        free(chunks->slots[i].records);
+    }
+    pthread_cond_destroy(&chunks->freeCond);
+    pthread_cond_destroy(&chunks->readyCond);
+    pthread_mutex_destroy(&chunks->lock);
+    free(chunks->threads);
+    free(chunks->slots);
+    free(chunks);
+}
+
+// Wait for the next chunk to be parsed
+static void traceChunksTake(trace_chunks_t* chunks)
+{
+    trace_chunk_t* chunk = &chunks->slots[chunks->consumed % chunks->slotCount];
+    pthread_mutex_lock(&chunks->lock);
+    while (!chunk->ready) {
+        pthread_cond_wait(&chunks->readyCond, &chunks->lock);
+    }
+    pthread_mutex_unlock(&chunks->lock);
+    chunks->current = chunk;
+    chunks->position = 0;
+}
+
+// Move on from a chunk whose records have all been read
+static void traceChunksFinish(trace_chunks_t* chunks)
+{
+    trace_chunk_t* chunk = chunks->current;
+    switch (chunk->status) {
+    case TRACE_CHUNK_CLEAN:
+        if (chunks->consumed + 1 == chunks->chunkCount) {
+            chunks->done = true;
+            chunks->eof = true;
+            return;
+        }
+        pthread_mutex_lock(&chunks->lock);
+        chunk->ready = false;
+        chunks->consumed++;
+        pthread_cond_broadcast(&chunks->freeCond);
+        pthread_mutex_unlock(&chunks->lock);
+        chunks->current = NULL;
+        return;
+    case TRACE_CHUNK_SPLIT:
+        // The rest of the trace is parsed serially, so the workers have nothing left to do
+        pthread_mutex_lock(&chunks->lock);
+        chunks->stopping = true;
+        pthread_cond_broadcast(&chunks->freeCond);
+        pthread_mutex_unlock(&chunks->lock);
+        traceReaderInitMemory(&chunks->tail, chunk->stop, (size_t)(chunks->end - chunk->stop));
+        chunks->serial = true;
+        chunks->done = true;
+        return;
+    case TRACE_CHUNK_MALFORMED:
+        chunks->done = true;
+        chunks->eof = false;
+        return;
+    }
+}
+
+// Read the next record
+// chunks - parser
+// id - set to the job id
+// arrivalTime - set to the job arrival time
+// jobTime - set to the job time
+// Returns true if all three values were read, false on a malformed record or the end of the trace
+bool traceChunksNext(trace_chunks_t* chunks, uint64_t* id, uint64_t* arrivalTime, uint64_t* jobTime)
+{
+    while (!chunks->done) {
+        if (chunks->current == NULL) {
+            traceChunksTake(chunks);
+        }
+        if (chunks->position < chunks->current->count) {
+            const trace_record_t* record = &chunks->current->records[chunks->position++];
+            *id = record->id;
+            *arrivalTime = record->time;
+            *jobTime = record->jobTime;
+            return true;
+        }
+        traceChunksFinish(chunks);
+    }
+    if (chunks->serial) {
+        return traceReaderNext(&chunks->tail, id, arrivalTime, jobTime);
+    }
+    return false;
+}
@@ -0,0 +1,85 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "trace_reader.h"
+#include "trace_binary.h"
+
+// Trace converter
+// Reads a text or binary trace and writes it in binary, or in text with -t. The binary
+// header holds the record count, so it is written last and the output must be seekable.
+
+// Print program usage info
+static void usage(char* program)
+{
+    printf("%s [-t] traceFile outFile\n", program);
+    printf("Converts a trace to the binary format, or to the text format with -t\n");
+}
+
+// Write one record in binary
+// Returns false on a write error
+static bool writeBinaryRecord(FILE* outFile, uint64_t id, uint64_t arrivalTime, uint64_t jobTime, uint64_t* lastId, uint64_t* lastArrivalTime)
+{
+    uint8_t record[3 * TRACE_BINARY_MAX_VARINT];
+    size_t size = traceBinaryPutVarint(record, traceBinaryZigzag(id - *lastId));
+    size += traceBinaryPutVarint(record + size, traceBinaryZigzag(arrivalTime - *lastArrivalTime));
+    size += traceBinaryPutVarint(record + size, jobTime);
+    *lastId = id;
+    *lastArrivalTime = arrivalTime;
+    return fwrite(record, 1, size, outFile) == size;
+}
+
+int main(int argc, char* argv[])
+{
+    bool text = argc == 4 && strcmp(argv[1], "-t") == 0;
+    if (argc != 3 && !text) {
+        usage(argv[0]);
+        return -1;
+    }
+    const char* traceFilename = argv[argc - 2];
+    const char* outFilename = argv[argc - 1];
+    trace_reader_t* reader = traceReaderOpen(traceFilename);
+    if (reader == NULL) {
+        printf("Invalid trace file: %s\n", traceFilename);
+        return -2;
+    }
+    FILE* outFile = fopen(outFilename, "wb");
+    if (outFile == NULL) {
+        printf("Invalid output file: %s\n", outFilename);
+        traceReaderClose(reader);
+        return -2;
+    }
+    uint8_t header[TRACE_BINARY_HEADER_SIZE];
+    bool ok = true;
+    if (!text) {
+        // Placeholder until the record count is known
+        traceBinaryPutHeader(header, 0);
+        ok = fwrite(header, 1, sizeof(header), outFile) == sizeof(header);
+    }
+    uint64_t records = 0;
+    uint64_t lastId = 0;
+    uint64_t lastArrivalTime = 0;
+    uint64_t id;
+    uint64_t arrivalTime;
+    uint64_t jobTime;
+    while (ok && traceReaderNext(reader, &id, &arrivalTime, &jobTime)) {
+        if (text) {
+            ok = fprintf(outFile, "%" PRIu64 ", %" PRIu64 ", %" PRIu64 "\n", id, arrivalTime, jobTime) > 0;
+        } else {
+            ok = writeBinaryRecord(outFile, id, arrivalTime, jobTime, &lastId, &lastArrivalTime);
+        }
+        records++;
+    }
+    if (ok && !traceReaderEof(reader)) {
+        printf("Invalid record %" PRIu64 " in trace file: %s\n", records + 1, traceFilename);
+        ok = false;
+    }
+    if (ok && !text) {
+        traceBinaryPutHeader(header, records);
+        ok = fseek(outFile, 0, SEEK_SET) == 0 && fwrite(header, 1, sizeof(header), outFile) == sizeof(header);
+    }
+    traceReaderClose(reader);
+    if (fclose(outFile) != 0) {
+        ok = false;
+    }
+    return ok ? 0 : -2;
+}
@@ -0,0 +1,301 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "trace_reader.h"
+#include "trace_binary.h"
+
+// The header is detected from the first buffer of a pipe
+_Static_assert(TRACE_READER_BUFFER_SIZE >= TRACE_BINARY_HEADER_SIZE, "trace reader buffer must hold a binary header");
+
+// Read from the file until the buffer holds at least size bytes or the file ends
+// Only used before parsing starts, so the buffer is appended to rather than refilled
+static void traceReaderPrefill(trace_reader_t* reader, size_t size)
+{
+    while ((size_t)(reader->end - reader->pos) < size && !reader->inputEnded) {
+        ssize_t bytes = read(reader->fd, reader->buffer + (reader->end - reader->pos), TRACE_READER_BUFFER_SIZE - (size_t)(reader->end - reader->pos));
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            reader->inputEnded = bytes == 0;
+            return;
+        }
+        reader->end += bytes;
+    }
+}
+
+// Check for a binary header and skip past it
+// Returns false if the header is binary but can't be read
+static bool traceReaderDetect(trace_reader_t* reader)
+{
+    if (reader->buffer != NULL) {
+        traceReaderPrefill(reader, TRACE_BINARY_HEADER_SIZE);
+    }
+    size_t available = (size_t)(reader->end - reader->pos);
+    if (available < TRACE_BINARY_MAGIC_SIZE || memcmp(reader->pos, TRACE_BINARY_MAGIC, TRACE_BINARY_MAGIC_SIZE) != 0) {
+        return true;
+    }
+    const uint8_t* header = (const uint8_t*)reader->pos;
+    if (available < TRACE_BINARY_HEADER_SIZE || traceBinaryGetLittleEndian(header + 8, 4) != TRACE_BINARY_VERSION) {
+        return false;
+    }
+    reader->binary = true;
+    reader->remaining = traceBinaryGetLittleEndian(header + 16, 8);
+    reader->pos += TRACE_BINARY_HEADER_SIZE;
+    return true;
+}
+
+// Open a trace file, text or binary
+// filename - path to trace file, or TRACE_READER_STDIN
+// Returns NULL if the file can't be opened, has an unsupported binary version or on allocation failure
+trace_reader_t* traceReaderOpen(const char* filename)
+{
+    trace_reader_t* reader = malloc(sizeof(trace_reader_t));
+    if (reader == NULL) {
+        return NULL;
+    }
+    // Standard input is duplicated so closing the reader never closes it
+    if (strcmp(filename, TRACE_READER_STDIN) == 0) {
+        reader->fd = dup(STDIN_FILENO);
+    } else {
+        reader->fd = open(filename, O_RDONLY);
+    }
+    if (reader->fd < 0) {
+        free(reader);
+        return NULL;
+    }
+    reader->map = NULL;
+    reader->mapSize = 0;
+    reader->buffer = NULL;
+    reader->inputEnded = false;
+    reader->eof = false;
+    reader->binary = false;
+    reader->remaining = 0;
+    reader->lastId = 0;
+    reader->lastArrivalTime = 0;
+    struct stat st;
+    if (fstat(reader->fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, reader->fd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+            reader->map = map;
+            reader->mapSize = (size_t)st.st_size;
+            reader->pos = reader->map;
+            reader->end = reader->map + reader->mapSize;
+            reader->inputEnded = true;
+            close(reader->fd);
+            reader->fd = -1;
+        }
+    }
+    if (reader->map == NULL) {
+        // Pipes, empty files and anything else mmap refuses are read through a buffer
+        reader->buffer = malloc(TRACE_READER_BUFFER_SIZE);
+        if (reader->buffer == NULL) {
+            close(reader->fd);
+            free(reader);
+            return NULL;
+        }
+        reader->pos = reader->buffer;
+        reader->end = reader->buffer;
+    }
+    if (!traceReaderDetect(reader)) {
+        traceReaderClose(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+// Set up a reader that parses text already in memory
+// reader - reader to set up
+// data - text trace, or part of one starting at a record
+// size - bytes of text
+void traceReaderInitMemory(trace_reader_t* reader, const char* data, size_t size)
+{
+    reader->fd = -1;
+    reader->pos = data;
+    reader->end = data + size;
+    reader->map = NULL;
+    reader->mapSize = 0;
+    reader->buffer = NULL;
+    reader->inputEnded = true;
+    reader->eof = false;
+    reader->binary = false;
+    reader->remaining = 0;
+    reader->lastId = 0;
+    reader->lastArrivalTime = 0;
+}
+
+// Close a trace file
+void traceReaderClose(trace_reader_t* reader)
+{
+    if (reader->map != NULL) {
+        munmap(reader->map, reader->mapSize);
+    }
+    if (reader->fd >= 0) {
+        close(reader->fd);
+    }
+    free(reader->buffer);
+    free(reader);
+}
+
+// Refill the buffer once everything in it has been parsed
+// Returns false at the end of the trace or on a read error
+static bool traceReaderFill(trace_reader_t* reader)
+{
+    if (reader->inputEnded) {
+        return false;
+    }
+    ssize_t bytes;
+    do {
+        bytes = read(reader->fd, reader->buffer, TRACE_READER_BUFFER_SIZE);
+    } while (bytes < 0 && errno == EINTR);
+    if (bytes <= 0) {
+        // Like stdio, a read error is not the end of file
+        reader->inputEnded = bytes == 0;
+        return false;
+    }
+    reader->pos = reader->buffer;
+    reader->end = reader->buffer + bytes;
+    return true;
+}
+
+// Returns the next character without consuming it, or -1 at the end of the trace
+static inline int traceReaderPeek(trace_reader_t* reader)
+{
+    if (reader->pos == reader->end && !traceReaderFill(reader)) {
+        reader->eof = reader->inputEnded;
+        return -1;
+    }
+    return (unsigned char)*reader->pos;
+}
+
+// Returns true for the characters isspace accepts in the C locale
+static inline bool traceReaderIsSpace(int c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Skip whitespace, like a space in a scanf format
+// Returns the next character, or -1 at the end of the trace
+static inline int traceReaderSkipSpace(trace_reader_t* reader)
+{
+    int c = traceReaderPeek(reader);
+    while (traceReaderIsSpace(c)) {
+        reader->pos++;
+        c = traceReaderPeek(reader);
+    }
+    return c;
+}
+
+// Parse an unsigned integer, like %lu in a scanf format
+// Leading whitespace and a sign are accepted, a negative value wraps around like strtoull
+// and a value that doesn't fit saturates to UINT64_MAX
+// Returns false if there are no digits
+static inline bool traceReaderNumber(trace_reader_t* reader, uint64_t* value)
+{
+    int c = traceReaderSkipSpace(reader);
+    bool negative = false;
+    if (c == '+' || c == '-') {
+        negative = c == '-';
+        reader->pos++;
+        c = traceReaderPeek(reader);
+    }
+    if (c < '0' || c > '9') {
+        return false;
+    }
+    uint64_t result = 0;
+    bool saturated = false;
+    do {
+        uint64_t digit = (uint64_t)(c - '0');
+        if (result > (UINT64_MAX - digit) / 10) {
+            saturated = true;
+        } else {
+            result = result * 10 + digit;
+        }
+        reader->pos++;
+        c = traceReaderPeek(reader);
+    } while (c >= '0' && c <= '9');
+    if (saturated) {
+        *value = UINT64_MAX;
+    } else {
+        *value = negative ? 0 - result : result;
+    }
+    return true;
+}
+
+// Match a separator, like ", " in a scanf format
+// The comma must come straight after the previous value, any whitespace may follow it
+// Returns false if the next character isn't a comma
+static inline bool traceReaderSeparator(trace_reader_t* reader)
+{
+    if (traceReaderPeek(reader) != ',') {
+        return false;
+    }
+    reader->pos++;
+    traceReaderSkipSpace(reader);
+    return true;
+}
+
+// Decode a varint from a binary trace
+// Running out of data part way is an error, not the end of the trace, so eof isn't set
+// Returns false if the trace is truncated or the varint is too long
+static inline bool traceReaderVarint(trace_reader_t* reader, uint64_t* value)
+{
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (reader->pos == reader->end && !traceReaderFill(reader)) {
+            return false;
+        }
+        uint8_t byte = (uint8_t)*reader->pos++;
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if (byte < 0x80) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Read the next record of a binary trace
+static bool traceReaderNextBinary(trace_reader_t* reader, uint64_t* id, uint64_t* arrivalTime, uint64_t* jobTime)
+{
+    if (reader->remaining == 0) {
+        reader->eof = true;
+        return false;
+    }
+    uint64_t idDelta;
+    uint64_t arrivalDelta;
+    if (!traceReaderVarint(reader, &idDelta) ||
+        !traceReaderVarint(reader, &arrivalDelta) ||
+        !traceReaderVarint(reader, jobTime)) {
+        return false;
+    }
+    reader->lastId += traceBinaryUnzigzag(idDelta);
+    reader->lastArrivalTime += traceBinaryUnzigzag(arrivalDelta);
+    *id = reader->lastId;
+    *arrivalTime = reader->lastArrivalTime;
+    reader->remaining--;
+    return true;
+}
+
+// Read the next record
+// reader - trace reader
+// id - set to the job id
+// arrivalTime - set to the job arrival time
+// jobTime - set to the job time
+// Returns true if all three values were read, false on a malformed record or the end of the trace
+bool traceReaderNext(trace_reader_t* reader, uint64_t* id, uint64_t* arrivalTime, uint64_t* jobTime)
+{
+    if (reader->binary) {
+        return traceReaderNextBinary(reader, id, arrivalTime, jobTime);
+    }
+    return traceReaderNumber(reader, id) &&
+           traceReaderSeparator(reader) &&
+           traceReaderNumber(reader, arrivalTime) &&
+           traceReaderSeparator(reader) &&
+           traceReaderNumber(reader, jobTime);
+}
@@ -0,0 +1,43 @@
+#ifndef TRACE_WRITER_H
+#define TRACE_WRITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define TRACE_WRITER_BUFFER_SIZE (1 << 20) // bytes collected before each write
+#define TRACE_WRITER_MAX_LINE 64 // longest line written in one call
+#define TRACE_WRITER_STDOUT "-" // output filename that writes to standard output
+
+// Simulator output writer
+// Formats completion lines straight into one large buffer and writes it out in big blocks,
+// producing the same bytes as fprintf with PRIu64 but with no locale or format parsing and
+// no allocation after the writer is opened. Output only goes out when the buffer fills or
+// the writer is closed, so a pipe reading standard output sees large blocks.
+typedef struct {
+    int fd; // output file descriptor
+    char* buffer; // formatted output not yet written
+    size_t used; // bytes in buffer
+    bool error; // set once a write has failed
+} trace_writer_t;
+
+// Open an output file, truncating it like fopen with "w"
+// filename - path to output file, or TRACE_WRITER_STDOUT
+// Returns NULL if the file can't be opened or on allocation failure
+trace_writer_t* traceWriterOpen(const char* filename);
+
+// Flush and close an output file
+// Returns false if any write failed
+bool traceWriterClose(trace_writer_t* writer);
+
+// Write out everything in the buffer
+// Returns false if the write failed
+bool traceWriterFlush(trace_writer_t* writer);
+
+// Write a completion line, "id, time\n"
+// writer - output writer
+// id - job id
+// time - completion time
+void traceWriterCompletion(trace_writer_t* writer, uint64_t id, uint64_t time);
+
+#endif /* TRACE_WRITER_H */
@@ -0,0 +1,252 @@
+#ifndef TYPED_QUEUE_H
+#define TYPED_QUEUE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TYPED_QUEUE_MIN_CAPACITY 8 // items held after the first allocation, a power of two
+
+// Type specialized queues
+// Each DEFINE_ macro generates a queue type and its static inline functions for one item type,
+// ordered by the key a KEY(item) expression computes from a pointer to an item. Keys compare
+// with <, so the comparison is inlined into every queue operation instead of going through a
+// compare_fn, and a key that packs several fields into one wide integer compares without
+// branches. Queues start empty without allocating, grow by doubling and return false from an
+// insert when they can't grow.
+
+// DEFINE_HEAP(queue_type, prefix, item_type, key_type, KEY)
+// Binary min-heap of item_type values, O(log n) push and pop
+// Keys should be unique, equal keys come out in no particular order
+// queue_type - name of the generated queue type
+// prefix - prefix of the generated functions, prefixInit, prefixPush and so on
+// item_type - type of the items, copied in and out by value
+// key_type - type of the keys, compared with <
+// KEY - expression or macro giving the key of a pointer to an item
+#define DEFINE_HEAP(queue_type, prefix, item_type, key_type, KEY) \
+typedef struct { \
+    item_type* items; /* heap array of items */ \
+    size_t count; /* number of items in the heap */ \
+    size_t capacity; /* allocated items in the heap array */ \
+} queue_type; \
+\
+/* Initializes an empty heap */ \
+static inline void prefix##Init(queue_type* queue) \
+{ \
+    queue->items = NULL; \
+    queue->count = 0; \
+    queue->capacity = 0; \
+} \
+\
+/* Frees the heap array, items still in the heap are dropped */ \
+static inline void prefix##Free(queue_type* queue) \
+{ \
+    free(queue->items); \
+} \
+\
+/* Returns the number of items in the heap */ \
+static inline size_t prefix##Count(const queue_type* queue) \
+{ \
+    return queue->count; \
+} \
+\
+/* Returns the item with the least key without removing it, or NULL if the heap is empty */ \
+static inline item_type* prefix##Peek(queue_type* queue) \
+{ \
+    return queue->count > 0 ? &queue->items[0] : NULL; \
+} \
+\
+/* Inserts an item in O(log n), returns false if the heap can't grow */ \
+static inline bool prefix##Push(queue_type* queue, item_type item) \
+{ \
+    if (queue->count == queue->capacity) { \
+        size_t capacity = queue->capacity > 0 ? 2 * queue->capacity : TYPED_QUEUE_MIN_CAPACITY; \
+        item_type* items = realloc(queue->items, capacity * sizeof(item_type)); \
+        if (items == NULL) { \
+            return false; \
+        } \
+        queue->items = items; \
+        queue->capacity = capacity; \
+    } \
+    /* Move the new item up until its parent goes before it */ \
+    key_type key = KEY(&item); \
+    size_t index = queue->count++; \
+    while (index > 0) { \
+        size_t parent = (index - 1) / 2; \
+        if (!(key < KEY(&queue->items[parent]))) { \
+            break; \
+        } \
+        queue->items[index] = queue->items[parent]; \
+        index = parent; \
+    } \
+    queue->items[index] = item; \
+    return true; \
+} \
+\
+/* Removes the item with the least key in O(log n) into item, returns false if the heap is empty */ \
+static inline bool prefix##Pop(queue_type* queue, item_type* item) \
+{ \
+    if (queue->count == 0) { \
+        return false; \
+    } \
+    *item = queue->items[0]; \
+    /* Move the last item down from the root until both children go after it */ \
+    item_type last = queue->items[--queue->count]; \
+    key_type key = KEY(&last); \
+    size_t count = queue->count; \
+    size_t index = 0; \
+    while (true) { \
+        size_t child = 2 * index + 1; \
+        if (child >= count) { \
+            break; \
+        } \
+        if (child + 1 < count && KEY(&queue->items[child + 1]) < KEY(&queue->items[child])) { \
+            child++; \
+        } \
+        if (!(KEY(&queue->items[child]) < key)) { \
+            break; \
+        } \
+        queue->items[index] = queue->items[child]; \
+        index = child; \
+    } \
+    queue->items[index] = last; \
+    return true; \
+}
+
+// DEFINE_SORTED_DEQUE(queue_type, prefix, item_type, key_type, KEY)
+// Ring buffer of item_type values sorted by key from front to back
+// Inserts walk in from the back and equal keys keep their insertion order, so items inserted
+// in key order cost O(1), as do pops from either end. Removing an item by key finds it with a
+// binary search and shifts the shorter side over the gap.
+// queue_type - name of the generated queue type
+// prefix - prefix of the generated functions, prefixInit, prefixInsert and so on
+// item_type - type of the items, copied in and out by value
+// key_type - type of the keys, compared with <
+// KEY - expression or macro giving the key of a pointer to an item
+#define DEFINE_SORTED_DEQUE(queue_type, prefix, item_type, key_type, KEY) \
+typedef struct { \
+    item_type* items; /* ring buffer of items */ \
+    size_t head; /* position of the front item */ \
+    size_t count; /* number of items in the deque */ \
+    size_t capacity; /* allocated items in the ring buffer, a power of two */ \
+} queue_type; \
+\
+/* Initializes an empty deque */ \
+static inline void prefix##Init(queue_type* queue) \
+{ \
+    queue->items = NULL; \
+    queue->head = 0; \
+    queue->count = 0; \
+    queue->capacity = 0; \
+} \
+\
+/* Frees the ring buffer, items still in the deque are dropped */ \
+static inline void prefix##Free(queue_type* queue) \
+{ \
+    free(queue->items); \
+} \
+\
+/* Returns the number of items in the deque */ \
+static inline size_t prefix##Count(const queue_type* queue) \
+{ \
+    return queue->count; \
+} \
+\
+/* Returns the item at the given position from the front, which must be less than the count */ \
+static inline item_type* prefix##At(queue_type* queue, size_t index) \
+{ \
+    return &queue->items[(queue->head + index) & (queue->capacity - 1)]; \
+} \
+\
+/* Returns the item with the least key, or NULL if the deque is empty */ \
+static inline item_type* prefix##Front(queue_type* queue) \
+{ \
+    return queue->count > 0 ? prefix##At(queue, 0) : NULL; \
+} \
+\
+/* Returns the item with the greatest key, or NULL if the deque is empty */ \
+static inline item_type* prefix##Back(queue_type* queue) \
+{ \
+    return queue->count > 0 ? prefix##At(queue, queue->count - 1) : NULL; \
+} \
+\
+/* Inserts an item after every item with a key no greater than its own */ \
+/* Returns false if the deque can't grow */ \
+static inline bool prefix##Insert(queue_type* queue, item_type item) \
+{ \
+    if (queue->count == queue->capacity) { \
+        size_t capacity = queue->capacity > 0 ? 2 * queue->capacity : TYPED_QUEUE_MIN_CAPACITY; \
+        item_type* items = realloc(queue->items, capacity * sizeof(item_type)); \
+        if (items == NULL) { \
+            return false; \
+        } \
+        /* The items that wrapped around to the start move up to follow on from the end */ \
+        memcpy(items + queue->capacity, items, queue->head * sizeof(item_type)); \
+        queue->items = items; \
+        queue->capacity = capacity; \
+    } \
+    key_type key = KEY(&item); \
+    size_t index = queue->count++; \
+    while (index > 0 && key < KEY(prefix##At(queue, index - 1))) { \
+        *prefix##At(queue, index) = *prefix##At(queue, index - 1); \
+        index--; \
+    } \
+    *prefix##At(queue, index) = item; \
+    return true; \
+} \
+\
+/* Removes the item with the least key into item, returns false if the deque is empty */ \
+static inline bool prefix##PopFront(queue_type* queue, item_type* item) \
+{ \
+    if (queue->count == 0) { \
+        return false; \
+    } \
+    *item = *prefix##At(queue, 0); \
+    queue->head = (queue->head + 1) & (queue->capacity - 1); \
+    queue->count--; \
+    return true; \
+} \
+\
+/* Removes the item with the greatest key into item, returns false if the deque is empty */ \
+static inline bool prefix##PopBack(queue_type* queue, item_type* item) \
+{ \
+    if (queue->count == 0) { \
+        return false; \
+    } \
+    *item = *prefix##At(queue, --queue->count); \
+    return true; \
+} \
+\
+/* Removes the first item with the given key into item, returns false if there is none */ \
+static inline bool prefix##Remove(queue_type* queue, key_type key, item_type* item) \
+{ \
+    size_t low = 0; \
+    size_t high = queue->count; \
+    while (low < high) { \
+        size_t middle = low + (high - low) / 2; \
+        if (KEY(prefix##At(queue, middle)) < key) { \
+            low = middle + 1; \
+        } else { \
+            high = middle; \
+        } \
+    } \
+    if (low == queue->count || key < KEY(prefix##At(queue, low))) { \
+        return false; \
+    } \
+    *item = *prefix##At(queue, low); \
+    if (low < queue->count / 2) { \
+        for (size_t index = low; index > 0; index--) { \
+            *prefix##At(queue, index) = *prefix##At(queue, index - 1); \
+        } \
+        queue->head = (queue->head + 1) & (queue->capacity - 1); \
+    } else { \
+        for (size_t index = low; index + 1 < queue->count; index++) { \
+            *prefix##At(queue, index) = *prefix##At(queue, index + 1); \
+        } \
+    } \
+    queue->count--; \
+    return true; \
+}
+
+#endif /* TYPED_QUEUE_H */
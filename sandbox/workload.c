@@ -0,0 +1,184 @@
+#include <math.h>
+#include <stdlib.h>
+#include "workload.h"
+
+// Returns the next pseudo random number (splitmix64)
+static uint64_t workloadRandom(workload_t* workload)
+{
+    uint64_t z = (workload->rng += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Returns a uniform random number in (0, 1)
+static double workloadUniform(workload_t* workload)
+{
+    return ((double)(workloadRandom(workload) >> 11) + 0.5) / 9007199254740992.0;
+}
+
+// Returns an exponentially distributed random number with the given mean
+static double workloadExponential(workload_t* workload, double mean)
+{
+    return -mean * log(workloadUniform(workload));
+}
+
+// Fill in the default configuration
+// config - configuration to fill in
+void workloadConfigDefault(workload_config_t* config)
+{
+    config->jobs = 1000;
+    config->seed = 1;
+    config->load = 0.8;
+    config->arrival = WORKLOAD_ARRIVAL_POISSON;
+    config->burstRatio = 10;
+    config->dwellTime = 1000;
+    config->size = WORKLOAD_SIZE_EXPONENTIAL;
+    config->meanSize = 10;
+    config->paretoAlpha = 1.1;
+    config->paretoMin = 1;
+    config->paretoMax = 100000;
+    config->smallSize = 1;
+    config->largeSize = 100;
+    config->largeProbability = 0.01;
+}
+
+// Returns the mean job time of a configuration
+double workloadMeanSize(const workload_config_t* config)
+{
+    switch (config->size) {
+    case WORKLOAD_SIZE_EXPONENTIAL:
+        return config->meanSize;
+    case WORKLOAD_SIZE_BOUNDED_PARETO: {
+        double a = config->paretoAlpha;
+        double l = config->paretoMin;
+        double h = config->paretoMax;
+        double scale = 1 / (1 - pow(l / h, a));
+        if (a == 1) {
+            return scale * l * log(h / l);
+        }
+        return scale * pow(l, a) * a / (a - 1) * (pow(l, 1 - a) - pow(h, 1 - a));
+    }
+    case WORKLOAD_SIZE_BIMODAL:
+        return (1 - config->largeProbability) * config->smallSize + config->largeProbability * config->largeSize;
+    }
+    return 0;
+}
+
+// Returns true if every parameter the configuration uses is in range
+static bool workloadConfigValid(const workload_config_t* config)
+{
+    if (!(config->load > 0)) {
+        return false;
+    }
+    if (config->arrival == WORKLOAD_ARRIVAL_MMPP && !(config->burstRatio >= 1 && config->dwellTime > 0)) {
+        return false;
+    }
+    switch (config->size) {
+    case WORKLOAD_SIZE_EXPONENTIAL:
+        return config->meanSize > 0;
+    case WORKLOAD_SIZE_BOUNDED_PARETO:
+        return config->paretoAlpha > 0 && config->paretoMin > 0 && config->paretoMax > config->paretoMin;
+    case WORKLOAD_SIZE_BIMODAL:
+        return config->smallSize > 0 && config->largeSize > 0 && config->largeProbability >= 0 && config->largeProbability <= 1;
+    }
+    return false;
+}
+
+// Create a workload generator
+// config - configuration, copied into the generator
+// Returns NULL if the configuration is invalid or on allocation failure
+workload_t* workloadCreate(const workload_config_t* config)
+{
+    if (!workloadConfigValid(config)) {
+        return NULL;
+    }
+    workload_t* workload = malloc(sizeof(workload_t));
+    if (workload == NULL) {
+        return NULL;
+    }
+    workload->config = *config;
+    workload->rng = config->seed;
+    workload->nextId = 1;
+    workload->clock = 0;
+    workload->meanInterarrival = workloadMeanSize(config) / config->load;
+    // Both states last as long on average, so the overall rate is the mean of the two
+    double rate = 1 / workload->meanInterarrival;
+    workload->burstRate = 2 * rate * config->burstRatio / (config->burstRatio + 1);
+    workload->lullRate = 2 * rate / (config->burstRatio + 1);
+    workload->burst = false;
+    workload->stateEnd = workloadExponential(workload, config->dwellTime);
+    return workload;
+}
+
+// Destroy a workload generator
+void workloadDestroy(workload_t* workload)
+{
+    free(workload);
+}
+
+// Returns the time between the previous arrival and the next
+static double workloadInterarrival(workload_t* workload)
+{
+    switch (workload->config.arrival) {
+    case WORKLOAD_ARRIVAL_POISSON:
+        return workloadExponential(workload, workload->meanInterarrival);
+    case WORKLOAD_ARRIVAL_MMPP: {
+        // Interarrivals are memoryless, so a draw that crosses a state change is
+        // thrown away and drawn again from the change at the new state's rate
+        double time = workload->clock;
+        while (true) {
+            double rate = workload->burst ? workload->burstRate : workload->lullRate;
+            double next = time + workloadExponential(workload, 1 / rate);
+            if (next <= workload->stateEnd) {
+                return next - workload->clock;
+            }
+            time = workload->stateEnd;
+            workload->burst = !workload->burst;
+            workload->stateEnd = time + workloadExponential(workload, workload->config.dwellTime);
+        }
+    }
+    case WORKLOAD_ARRIVAL_DETERMINISTIC:
+        return workload->meanInterarrival;
+    }
+    return 0;
+}
+
+// Returns the next job time
+static double workloadSize(workload_t* workload)
+{
+    const workload_config_t* config = &workload->config;
+    switch (config->size) {
+    case WORKLOAD_SIZE_EXPONENTIAL:
+        return workloadExponential(workload, config->meanSize);
+    case WORKLOAD_SIZE_BOUNDED_PARETO: {
+        // Inverse of the bounded Pareto CDF
+        double a = config->paretoAlpha;
+        double tail = 1 - pow(config->paretoMin / config->paretoMax, a);
+        return config->paretoMin / pow(1 - workloadUniform(workload) * tail, 1 / a);
+    }
+    case WORKLOAD_SIZE_BIMODAL:
+        return workloadUniform(workload) < config->largeProbability ? config->largeSize : config->smallSize;
+    }
+    return 0;
+}
+
+// Generate the next job
+// workload - generator
+// id - set to the job id
+// arrivalTime - set to the job arrival time
+// jobTime - set to the job time, at least 1
+// Returns false once all the jobs have been generated
+bool workloadNext(workload_t* workload, uint64_t* id, uint64_t* arrivalTime, uint64_t* jobTime)
+{
+    if (workload->nextId > workload->config.jobs) {
+        return false;
+    }
+    // Arrivals are kept unrounded so rounding errors don't add up over the trace
+    workload->clock += workloadInterarrival(workload);
+    double size = round(workloadSize(workload));
+    *id = workload->nextId++;
+    *arrivalTime = (uint64_t)llround(workload->clock);
+    *jobTime = size >= 1 ? (uint64_t)size : 1;
+    return true;
+}
@@ -20,6 +20,7 @@ scheduler_t* schedulerCreate(const char* schedulerName, simulator_t* sim, comple
     scheduler->completionCallback = completionCallback;
     scheduler->completionCallbackData = completionCallbackData;
     scheduler->completionEvent = NULL;
+    scheduler->failed = false;
     if (strcmp(schedulerName, "FCFS") == 0) {
         INIT_SCHEDULER(scheduler, FCFS);
     } else if (strcmp(schedulerName, "LCFS") == 0) {
@@ -89,6 +90,7 @@ bool schedulerScheduleNextCompletion(scheduler_t* scheduler, uint64_t timestamp)
     scheduler->completionEvent = simulatorSchedule(scheduler->sim, timestamp, EVENT_COMPLETION, schedulerCompleteJob, scheduler);
     // Check for failure to schedule
     if (scheduler->completionEvent == NULL) {
+        schedulerFail(scheduler);
         return false;
     }
     return true;
@@ -106,3 +108,30 @@ bool schedulerCancelNextCompletion(scheduler_t* scheduler)
     scheduler->completionEvent = NULL;
     return true;
 }
+
+// Move the next completion to the given time, or schedule it if there isn't one
+// Returns true on success, false otherwise
+bool schedulerRescheduleNextCompletion(scheduler_t* scheduler, uint64_t timestamp)
+{
+    if (scheduler->completionEvent == NULL) {
+        return schedulerScheduleNextCompletion(scheduler, timestamp);
+    }
+    if (!simulatorReschedule(scheduler->sim, scheduler->completionEvent, timestamp)) {
+        scheduler->completionEvent = NULL;
+        schedulerFail(scheduler);
+        return false;
+    }
+    return true;
+}
+
+// Mark the run as failed
+void schedulerFail(scheduler_t* scheduler)
+{
+    scheduler->failed = true;
+}
+
+// Returns true if a job or completion was lost during the run
+bool schedulerFailed(scheduler_t* scheduler)
+{
+    return scheduler->failed;
+}
@@ -40,7 +40,8 @@ typedef struct scheduler {
     simulator_t* sim; // simulator
     completionCallback_fn completionCallback; // function to call upon job completion
     void* completionCallbackData; // data to pass to callback function
-    list_node_t* completionEvent; // completion event reference
+    event_t* completionEvent; // completion event reference
+    bool failed; // a job or completion was lost, so the run's results are invalid
 } scheduler_t;
 
 // Creates a scheduler
@@ -68,6 +69,20 @@ bool schedulerScheduleNextCompletion(scheduler_t* scheduler, uint64_t timestamp)
 // Returns true on success, false otherwise
 bool schedulerCancelNextCompletion(scheduler_t* scheduler);
 
+// Move the next completion to the given time, or schedule it if there isn't one
+// Equivalent to schedulerCancelNextCompletion followed by schedulerScheduleNextCompletion,
+// but the pending completion event is updated in place
+// Returns true on success, false otherwise
+bool schedulerRescheduleNextCompletion(scheduler_t* scheduler, uint64_t timestamp);
+
+// Mark the run as failed
+// Called when a job or completion can't be scheduled, such as on allocation failure. The
+// simulation carries on without it and the run is reported as failed once it ends.
+void schedulerFail(scheduler_t* scheduler);
+
+// Returns true if a job or completion was lost during the run
+bool schedulerFailed(scheduler_t* scheduler);
+
 // Defines scheduler specific functions
 #define DEFINE_SCHEDULER(schedulerName)                                 \
     void* scheduler ## schedulerName ## Create();                       \
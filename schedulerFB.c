@@ -1,38 +1,169 @@
 #include <stdint.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
 #include "scheduler.h"
 #include "job.h"
 #include "linked_list.h"
 
-#include "stdio.h"
+#define FB_LEVELS_INITIAL_CAPACITY 64 // levels held before the first resize
+
+// Jobs with the same attained service
+// Only the lowest level runs, sharing the processor equally between its jobs. Time that
+// doesn't divide into a whole unit for every job is kept as credit, so no time is lost.
+typedef struct {
+    uint64_t attained; // service every job in the level has attained
+    uint64_t credit; // time spent on the level not yet shared out, less than count
+    uint64_t count; // jobs in the level
+    list_node_t* jobs; // pairing heap of the jobs, first to finish at the root
+} FB_level_t;
 
 // FB scheduler info
+// Levels form a stack with the lowest attained service on top. A new job has attained
+// nothing, so it joins the top level or pushes a new one, and only the top level gains
+// service, so it can only catch up with the level below it. When it does the two merge
+// into one level, at a completion event that completes no job. Each event costs O(1) level
+// operations and one pairing heap operation.
 typedef struct {
-    list_t* FB_list; 
-    uint64_t time_to_run;
-    uint64_t last_job_run_time; 
+    FB_level_t* levels; // levels, lowest attained service last
+    size_t num_levels;
+    size_t level_capacity;
+    uint64_t last_job_run_time;
     uint64_t num_jobs;
-    int running_jobs; 
-
-    list_t* completed_jobs; 
-    job_t* completed_job; 
 } scheduler_FB_t;
 
-uint64_t jobGetAttainedService(job_t* job)
+// Jobs in a level are linked through their intrusive nodes into a pairing heap
+// A node's prev points to its first child and next to its next sibling
+
+// Returns true if the job at node1 finishes before the job at node2 in the same level
+// Jobs in a level have attained the same service, so the shorter job finishes first, ties by id
+static inline bool FB_before(list_node_t* node1, list_node_t* node2)
+{
+    job_t* job1 = list_data(node1);
+    job_t* job2 = list_data(node2);
+    if (jobGetJobTime(job1) != jobGetJobTime(job2)) {
+        return jobGetJobTime(job1) < jobGetJobTime(job2);
+    }
+    return jobGetId(job1) < jobGetId(job2);
+}
+
+// Melds two pairing heaps and returns the new root
+static list_node_t* FB_meld(list_node_t* heap1, list_node_t* heap2)
+{
+    if (heap1 == NULL) {
+        return heap2;
+    }
+    if (heap2 == NULL) {
+        return heap1;
+    }
+    if (FB_before(heap2, heap1)) {
+        list_node_t* swap = heap1;
+        heap1 = heap2;
+        heap2 = swap;
+    }
+    heap2->next = heap1->prev;
+    heap1->prev = heap2;
+    return heap1;
+}
+
+// Removes the root of a pairing heap and returns the new root
+static list_node_t* FB_pop(list_node_t* root)
+{
+    // Meld the children in pairs, then meld the pairs from last to first
+    list_node_t* child = root->prev;
+    list_node_t* pairs = NULL;
+    while (child != NULL) {
+        list_node_t* first = child;
+        list_node_t* second = first->next;
+        child = second != NULL ? second->next : NULL;
+        first->next = NULL;
+        if (second != NULL) {
+            second->next = NULL;
+        }
+        list_node_t* pair = FB_meld(first, second);
+        pair->next = pairs;
+        pairs = pair;
+    }
+    list_node_t* heap = NULL;
+    while (pairs != NULL) {
+        list_node_t* pair = pairs;
+        pairs = pair->next;
+        pair->next = NULL;
+        heap = FB_meld(heap, pair);
+    }
+    return heap;
+}
+
+// Returns the job time of the first job to finish in a level
+static inline uint64_t FB_level_min_job_time(FB_level_t* level)
+{
+    return jobGetJobTime(list_data(level->jobs));
+}
+
+// Pushes a new level with a single job on top of the stack
+// Returns false on allocation failure
+static bool FB_push_level(scheduler_FB_t* info, list_node_t* node)
 {
-    return (jobGetJobTime(job) - jobGetRemainingTime(job));
+    if (info->num_levels == info->level_capacity) {
+        FB_level_t* levels = realloc(info->levels, 2 * info->level_capacity * sizeof(FB_level_t));
+        if (levels == NULL) {
+            return false;
+        }
+        info->levels = levels;
+        info->level_capacity *= 2;
+    }
+    FB_level_t* level = &info->levels[info->num_levels++];
+    level->attained = 0;
+    level->credit = 0;
+    level->count = 1;
+    level->jobs = node;
+    return true;
+}
+
+// Shares the time since the last event between the jobs in the top level
+// Events are scheduled for every merge, so the top level never passes the level below it
+static void FB_advance(scheduler_FB_t* info, uint64_t currentTime)
+{
+    uint64_t elapsed = currentTime - info->last_job_run_time;
+    info->last_job_run_time = currentTime;
+    if (info->num_levels == 0) {
+        return;
+    }
+    FB_level_t* top = &info->levels[info->num_levels - 1];
+    uint64_t total = elapsed + top->credit;
+    top->attained += total / top->count;
+    top->credit = total % top->count;
+    assert(info->num_levels == 1 || top->attained <= top[-1].attained);
 }
 
-int FB_compare(void* data1, void* data2)
+// Merges the top level into the level below it for as long as they have caught up
+// A job finishing right now completes first, since the level below may hold credit
+static void FB_merge_levels(scheduler_FB_t* info)
 {
-    uint64_t attained_time1 = jobGetAttainedService((job_t*) data1);    
-    uint64_t attained_time2 = jobGetAttainedService((job_t*) data2);  
-    if (attained_time1 == attained_time2) {
-        return 0;
-    } else if (attained_time1 > attained_time2) {
-        return -1;
+    while (info->num_levels >= 2) {
+        FB_level_t* top = &info->levels[info->num_levels - 1];
+        FB_level_t* below = top - 1;
+        if (top->credit != 0 || top->attained != below->attained || FB_level_min_job_time(top) == top->attained) {
+            return;
+        }
+        below->jobs = FB_meld(below->jobs, top->jobs);
+        below->count += top->count;
+        info->num_levels--;
+    }
+}
+
+// Returns the time of the next event, the top level's first completion or its merge
+static uint64_t FB_next_event_time(scheduler_FB_t* info, uint64_t currentTime)
+{
+    FB_level_t* top = &info->levels[info->num_levels - 1];
+    uint64_t next_time = currentTime + (FB_level_min_job_time(top) - top->attained) * top->count - top->credit;
+    if (info->num_levels >= 2) {
+        uint64_t merge_time = currentTime + (top[-1].attained - top->attained) * top->count - top->credit;
+        if (merge_time < next_time) {
+            next_time = merge_time;
+        }
     }
-    return 1; 
+    return next_time;
 }
 
 // Creates and returns scheduler specific info
@@ -42,15 +173,16 @@ void* schedulerFBCreate()
     if (info == NULL) {
         return NULL;
     }
+    info->levels = malloc(FB_LEVELS_INITIAL_CAPACITY * sizeof(FB_level_t));
+    if (info->levels == NULL) {
+        free(info);
+        return NULL;
+    }
 
-    info->FB_list = list_create(NULL); 
-    info->time_to_run = 0;
-    info->last_job_run_time = 0; 
-    info->num_jobs = 0; 
-    info->running_jobs = 0; 
-
-    info->completed_jobs = list_create(NULL); 
-    info->completed_job = NULL; 
+    info->num_levels = 0;
+    info->level_capacity = FB_LEVELS_INITIAL_CAPACITY;
+    info->last_job_run_time = 0;
+    info->num_jobs = 0;
     return info;
 }
 
@@ -59,8 +191,7 @@ void schedulerFBDestroy(void* schedulerInfo)
 {
     scheduler_FB_t* info = (scheduler_FB_t*)schedulerInfo;
 
-    list_destroy(info->FB_list); 
-    list_destroy(info->completed_jobs);
+    free(info->levels);
     free(info);
 }
 
@@ -71,192 +202,58 @@ void schedulerFBDestroy(void* schedulerInfo)
 // currentTime - the current simulated time
 void schedulerFBScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
 {
-    /*
-     * Init some func vars
-     */
     scheduler_FB_t* info = (scheduler_FB_t*)schedulerInfo;
-    list_t* list = info->FB_list; 
-
-    /*
-     * Loop through PS_list, update each job's rem time 
-     * Set = (currentTime - last_job_run_time)/num_jobs = total time taken since last job / total num jobs
-     */
-    list_node_t* curr_node = list_head(list); 
-    while(curr_node != NULL)
-    {
-        uint64_t time_proccessed = ((currentTime - info->last_job_run_time)/info->num_jobs); 
-        jobSetRemainingTime(curr_node->data, jobGetRemainingTime(curr_node->data) - time_proccessed); 
-        curr_node = list_next(curr_node); 
-    }
-
-    /*
-     * Insert new job into PS_list and update num_jobs 
-     * Also init jobGetRemainingTime so that it is greater than 0
-     */
-    list_insert(list, job); 
-    (info->num_jobs)++; 
-    info->time_to_run = jobGetRemainingTime(job); 
-
-    /*
-     * Loop trhough PS_list, update time_to_run to be equal to the least job rem time of all available jobs
-     */
-    curr_node = list_head(list); 
-    while(curr_node != NULL)
-    {
-        //set time_to_run to the shortest remaining job time
-        if(jobGetRemainingTime(curr_node->data) < info->time_to_run)
-        {
-            info->time_to_run = jobGetRemainingTime(curr_node->data);
-        }
-        curr_node = list_next(curr_node); 
-    }
+    FB_advance(info, currentTime);
 
     /*
-     * If jobs were previously running, cancel next completion
+     * The new job has attained nothing, so it goes into a level of its own on top,
+     * and straight into the level below if that hasn't been served yet either
      */
-    if(info->running_jobs == 1)
-    {
-        schedulerCancelNextCompletion(scheduler); 
+    list_node_t* node = jobGetNode(job);
+    node->prev = NULL;
+    node->next = NULL;
+    node->data = job;
+    if (!FB_push_level(info, node)) {
+        // The levels in the system are untouched, so their pending event still stands
+        schedulerFail(scheduler);
+        return;
     }
+    info->num_jobs++;
+    FB_merge_levels(info);
 
-    /*
-     * Schedule next job for completion time: currentTime + (time to run * num jobs)
-     * Each job will run for time_to_run via processor sharing
-     */
-    info->last_job_run_time = currentTime; 
-    info->running_jobs = 1; 
-    uint64_t time_to_completion = currentTime + (info->time_to_run * info->num_jobs); 
-    schedulerScheduleNextCompletion(scheduler, time_to_completion);
-
-    /*
-     * Prints current PS_list
-     */
-    printf("schedule job - curr list time: %ld\n", currentTime);
-    curr_node = list_head(list); 
-    while(curr_node)
-    {
-        printf("%ld, rem: %ld \n", jobGetId(list_data(curr_node)), jobGetRemainingTime(list_data(curr_node)));
-        curr_node = list_next(curr_node); 
-    }
-    printf("-----END LIST\n\n\n");
+    schedulerRescheduleNextCompletion(scheduler, FB_next_event_time(info, currentTime));
 }
 
-
-
-
-
-
-
-
-
-
-
 // Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
 // schedulerInfo - scheduler specific info from create function
 // scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
 // currentTime - the current simulated time
-// Returns the job that is being completed
+// Returns the job that is being completed, or NULL when the top level only caught up
 job_t* schedulerFBCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
 {
-    /*
-     * Init some func vars
-     */
     scheduler_FB_t* info = (scheduler_FB_t*)schedulerInfo;
-    list_t* list = info->FB_list; 
-
-    //this sets time to run to the max time to run so the min can be found later
-    list_node_t* curr_node = list_head(list); 
-    while(curr_node != NULL)
-    {
-        if(jobGetRemainingTime(curr_node->data) > info->time_to_run)
-        {
-            info->time_to_run = jobGetRemainingTime(curr_node->data);
-        }
-        
-        curr_node = list_next(curr_node); 
-    }
-    /*
-     * Loop through PS_list, update each job's rem time 
-     * Set = (currentTime - last_job_run_time)/num_jobs = total time taken since last job / total num jobs
-     * 
-     * Loop trhough PS_list, get all completed jobs and insert them into completed_jobs
-     * 
-     * Also: update time_to_run to be equal to the least job rem time of all available jobs
-     */
-    curr_node = list_head(list); 
-    while(curr_node != NULL)
-    {
-        uint64_t time_proccessed = ((currentTime - info->last_job_run_time)/info->num_jobs); 
-        jobSetRemainingTime(curr_node->data, jobGetRemainingTime(curr_node->data) - time_proccessed); 
+    FB_advance(info, currentTime);
 
-        if(jobGetRemainingTime(curr_node->data) == 0 && list_find(info->completed_jobs, curr_node->data) == NULL)
-        {
-            list_insert(info->completed_jobs, curr_node->data);
-        }
-
-        //init info->time_to_run  
-        else if(jobGetRemainingTime(curr_node->data) < info->time_to_run && jobGetRemainingTime(curr_node->data) > 0)
-        {
-            info->time_to_run = jobGetRemainingTime(curr_node->data); 
-        }
-
-        curr_node = list_next(curr_node); 
-    }
-    
     /*
-     * If completed_jobs, this func will collect the first completed job and return it, it will also set the next completion for the curr time 
-     * if more jobs need to be returned
+     * Complete the first job in the top level if it has finished, jobs finishing together go
+     * one per event in id order, otherwise the top level has caught up with the one below
      */
-    if(list_head(info->completed_jobs) != NULL)
-    {
-        list_node_t* comnpleted_job_node = list_head(info->completed_jobs); 
-
-        info->completed_job = list_data(comnpleted_job_node); 
-
-        list_remove(list, list_find(list, info->completed_job)); 
+    FB_level_t* top = &info->levels[info->num_levels - 1];
+    job_t* completed_job = NULL;
+    if (top->credit == 0 && FB_level_min_job_time(top) == top->attained) {
+        completed_job = list_data(top->jobs);
+        top->jobs = FB_pop(top->jobs);
+        jobSetRemainingTime(completed_job, 0);
         info->num_jobs--;
-
-        list_remove(info->completed_jobs, comnpleted_job_node); 
-
-        if(list_head(info->completed_jobs) != NULL)
-        {
-            schedulerScheduleNextCompletion(scheduler, currentTime); 
-            //schedulerPSCompleteJob(schedulerInfo, scheduler, currentTime); 
+        if (--top->count == 0) {
+            info->num_levels--;
         }
     }
+    FB_merge_levels(info);
 
-    /*
-     * Schedule next job for completion time: currentTime + (time to run * num jobs)
-     * Each job will run for time_to_run via processor sharing
-     * 
-     * If there are no jobs or the time to run = 0 then we will not run any jobs and update running jobs accordingly
-     */
-    uint64_t time_to_completion = currentTime + (info->time_to_run * info->num_jobs); 
-    info->last_job_run_time = currentTime; 
-    if(info->num_jobs != 0)
-    {
-        //run batch of jobs (running_jobs = 1)
-        info->running_jobs = 1;
-        schedulerScheduleNextCompletion(scheduler, time_to_completion);
-    }
-    else
-    {
-        //no jobs being run (running_jobs = -1)
-        info->running_jobs = -1; 
+    if (info->num_jobs != 0) {
+        schedulerScheduleNextCompletion(scheduler, FB_next_event_time(info, currentTime));
     }
 
-    /*
-     * Prints current PS_list
-     */
-    printf("complete job - curr list time: %ld\n", currentTime);
-    curr_node = list_head(list); 
-    while(curr_node)
-    {
-        printf("%ld, rem: %ld \n", jobGetId(list_data(curr_node)), jobGetRemainingTime(list_data(curr_node)));
-        curr_node = list_next(curr_node); 
-    }
-    printf("-----END LIST\n\n\n");
-
-    return info->completed_job; 
-
+    return completed_job;
 }
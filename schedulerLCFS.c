@@ -2,27 +2,16 @@
 #include <stdlib.h>
 #include "scheduler.h"
 #include "job.h"
-#include "linked_list.h"
+#include "job_deque.h"
 
 // LCFS scheduler info
+// Waiting jobs are queued in arrival order and the newest runs next
+// The running job is kept out of the queue
 typedef struct {
-    list_t* LCFS_list; 
-    job_t* curr_job;
+    job_deque_t LCFS_queue;
+    job_t* curr_job; 
 } scheduler_LCFS_t;
 
-// Compare function designed for FCFS to be given to linked list
-int LCFS_compare(void* data1, void* data2)
-{
-    uint64_t arrival_time1 = jobGetArrivalTime(data1);
-    uint64_t arrival_time2 = jobGetArrivalTime(data2);
-    if (arrival_time1 == arrival_time2) {
-        return 0;
-    } else if (arrival_time1 > arrival_time2) {
-        return -1;
-    }
-    return 1; 
-}
-
 // Creates and returns scheduler specific info
 void* schedulerLCFSCreate()
 {
@@ -31,7 +20,7 @@ void* schedulerLCFSCreate()
         return NULL;
     }
 
-    info->LCFS_list = list_create(LCFS_compare); 
+    jobDequeInit(&info->LCFS_queue); 
     info->curr_job = NULL; 
     return info;
 }
@@ -41,7 +30,7 @@ void schedulerLCFSDestroy(void* schedulerInfo)
 {
     scheduler_LCFS_t* info = (scheduler_LCFS_t*)schedulerInfo;
 
-    list_destroy(info->LCFS_list); 
+    jobDequeFree(&info->LCFS_queue);
     free(info);
 }
 
@@ -53,15 +42,18 @@ void schedulerLCFSDestroy(void* schedulerInfo)
 void schedulerLCFSScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
 {
     scheduler_LCFS_t* info = (scheduler_LCFS_t*)schedulerInfo;
-    list_t* list = info->LCFS_list; 
 
-    list_insert(list, (void*)job); 
-    //if the inserted job is the only job in queue then we scheule its completion
-    if(list_next(list_head(list)) == NULL || info->curr_job == NULL)
+    //if no other job is being done, start the incoming job
+    if(info->curr_job == NULL)
     {
-        uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(job);
         info->curr_job = job; 
         schedulerScheduleNextCompletion(scheduler, job_completion_time); 
+        return; 
+    }
+    if(!jobDequeInsert(&info->LCFS_queue, job))
+    {
+        schedulerFail(scheduler);
     }
 }
 
@@ -73,20 +65,15 @@ void schedulerLCFSScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t
 job_t* schedulerLCFSCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
 {
     scheduler_LCFS_t* info = (scheduler_LCFS_t*)schedulerInfo;
-    list_t* list = info->LCFS_list; 
-    job_t* completed_job = info->curr_job; 
-
-    list_remove(list, list_find(list, completed_job)); 
-    if(list_tail(list) != NULL)
+    job_t* completed_job = info->curr_job;  
+    
+    //start the newest waiting job, if any
+    info->curr_job = jobDequePopNewest(&info->LCFS_queue); 
+    if(info->curr_job != NULL)
     {
-        uint64_t job_completion_time = currentTime + jobGetRemainingTime(list_data(list_head(list))); 
-        info->curr_job = list_data(list_head(list)); 
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job);
         schedulerScheduleNextCompletion(scheduler, job_completion_time); 
     }
-    else
-    {
-        info->curr_job = NULL; 
-    }
-
+    
     return completed_job;
 }
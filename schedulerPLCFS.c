@@ -2,28 +2,17 @@
 #include <stdlib.h>
 #include "scheduler.h"
 #include "job.h"
-#include "linked_list.h"
+#include "job_deque.h"
 
 // PLCFS scheduler info
+// Preempted jobs are queued in arrival order and the newest resumes next
+// The running job is kept out of the queue
 typedef struct {
-    list_t* PLCFS_list; 
+    job_deque_t PLCFS_queue; 
     job_t* curr_job;
     uint64_t last_working_time; 
 } scheduler_PLCFS_t;
 
-// Compare function designed for FCFS to be given to linked list
-int PLCFS_compare(void* data1, void* data2)
-{
-    uint64_t arrival_time1 = jobGetArrivalTime(data1);
-    uint64_t arrival_time2 = jobGetArrivalTime(data2);
-    if (arrival_time1 == arrival_time2) {
-        return 0;
-    } else if (arrival_time1 > arrival_time2) {
-        return -1;
-    }
-    return 1; 
-}
-
 // Creates and returns scheduler specific info
 void* schedulerPLCFSCreate()
 {
@@ -32,7 +21,7 @@ void* schedulerPLCFSCreate()
         return NULL;
     }
 
-    info->PLCFS_list = list_create(PLCFS_compare);
+    jobDequeInit(&info->PLCFS_queue);
     info->curr_job = NULL; 
     return info;
 }
@@ -42,7 +31,7 @@ void schedulerPLCFSDestroy(void* schedulerInfo)
 {
     scheduler_PLCFS_t* info = (scheduler_PLCFS_t*)schedulerInfo;
 
-    list_destroy(info->PLCFS_list);
+    jobDequeFree(&info->PLCFS_queue);
     free(info);
 }
 
@@ -54,17 +43,22 @@ void schedulerPLCFSDestroy(void* schedulerInfo)
 void schedulerPLCFSScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
 {
     scheduler_PLCFS_t* info = (scheduler_PLCFS_t*)schedulerInfo;
-    list_t* list = info->PLCFS_list; 
 
+    //the running job is preempted, its pending completion is moved to the new job below
     if(info->curr_job != NULL){
         jobSetRemainingTime(info->curr_job, jobGetRemainingTime(info->curr_job)-(currentTime - info->last_working_time)); 
-        schedulerCancelNextCompletion(scheduler);
+        info->last_working_time = currentTime; 
+        if(!jobDequeInsert(&info->PLCFS_queue, info->curr_job))
+        {
+            //the running job carries on and the incoming job is lost
+            schedulerFail(scheduler);
+            return;
+        }
     }
-    list_insert(list, (void*)job);
     uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
     info->curr_job = job; 
     info->last_working_time = currentTime; 
-    schedulerScheduleNextCompletion(scheduler, job_completion_time);
+    schedulerRescheduleNextCompletion(scheduler, job_completion_time);
 }
 
 // Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
@@ -75,20 +69,15 @@ void schedulerPLCFSScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_
 job_t* schedulerPLCFSCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
 {
     scheduler_PLCFS_t* info = (scheduler_PLCFS_t*)schedulerInfo;
-    list_t* list = info->PLCFS_list; 
     job_t* completed_job = info->curr_job; 
 
-    list_remove(list, list_find(list, completed_job)); 
-    if(list_head(list)!=NULL)
+    //resume the most recently preempted job, if any
+    info->curr_job = jobDequePopNewest(&info->PLCFS_queue); 
+    if(info->curr_job != NULL)
     {
-        uint64_t job_completion_time = currentTime + jobGetRemainingTime(list_data(list_head(list))); 
-        info->curr_job = list_data(list_head(list)); 
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job); 
         info->last_working_time = currentTime; 
         schedulerScheduleNextCompletion(scheduler, job_completion_time);
     }
-    else
-    {
-        info->curr_job = NULL; 
-    }
     return completed_job;
 }
@@ -1,24 +1,187 @@
 #include <stdint.h>
 #include <stdlib.h>
+#include <assert.h>
 #include "scheduler.h"
 #include "job.h"
-#include "linked_list.h"
 
-#include "stdio.h"
+#define PS_TREE_MIN_LEAVES 64 // fewest arrival slots in the finish tag tree, a power of two
 
 // PS scheduler info
+// Every job in the system gets the same share of the processor, so instead of charging each
+// job on every event a global virtual time counts the service each job has attained. A job's
+// finish tag is its remaining time plus the virtual time when it arrived, and its remaining
+// time is its tag less the current virtual time.
+//
+// The integer division leaves a remainder that the next arrival hands out one unit at a time
+// to the newest jobs, so tags can also drop for a run of jobs in arrival order. A binary heap
+// can't shift part of itself, so the tags are kept in a min tree over arrival slots instead,
+// where a node can hold a pending shift for all the slots below it. Arrivals take the next
+// slot, the tree is compacted into a new one once the slots run out, and the first smallest
+// tag is the oldest job with the least remaining time. Arrivals and completions are O(log n).
 typedef struct {
-    list_t* PS_list;
-    uint64_t time_to_run;
-    uint64_t remainder_time; 
+    uint64_t* tag_min; // smallest finish tag below each node, after the node's own shift
+    uint64_t* tag_shift; // shift added to every tag below each node, stored mod 2^64
+    uint64_t* tag_count; // jobs below each node
+    job_t** slot_job; // job in each arrival slot
+    size_t slots; // arrival slots, leaves of the tree
+    size_t next_slot; // next free arrival slot
+
+    uint64_t virtual_time; // service attained by every job since the start
+    uint64_t remainder_time; // newest jobs that get an extra unit at the next arrival
     uint64_t last_job_run_time;
     uint64_t num_jobs;
-    int running_jobs; 
-
-    list_t* completed_jobs; 
-    job_t* completed_job; 
 } scheduler_PS_t;
 
+// Allocates an empty tree with the given number of arrival slots
+// Returns false on allocation failure
+static bool PS_tree_alloc(scheduler_PS_t* info, size_t slots)
+{
+    info->tag_min = malloc(2 * slots * sizeof(uint64_t));
+    info->tag_shift = calloc(2 * slots, sizeof(uint64_t));
+    info->tag_count = calloc(2 * slots, sizeof(uint64_t));
+    info->slot_job = malloc(slots * sizeof(job_t*));
+    if (info->tag_min == NULL || info->tag_shift == NULL || info->tag_count == NULL || info->slot_job == NULL) {
+        free(info->tag_min);
+        free(info->tag_shift);
+        free(info->tag_count);
+        free(info->slot_job);
+        return false;
+    }
+    info->slots = slots;
+    info->next_slot = 0;
+    return true;
+}
+
+// Frees the tree
+static void PS_tree_free(scheduler_PS_t* info)
+{
+    free(info->tag_min);
+    free(info->tag_shift);
+    free(info->tag_count);
+    free(info->slot_job);
+}
+
+// Recomputes a node from its children
+static inline void PS_tree_pull(scheduler_PS_t* info, size_t node)
+{
+    size_t left = 2 * node;
+    size_t right = left + 1;
+    info->tag_count[node] = info->tag_count[left] + info->tag_count[right];
+    uint64_t min;
+    if (info->tag_count[left] == 0) {
+        min = info->tag_min[right];
+    } else if (info->tag_count[right] == 0) {
+        min = info->tag_min[left];
+    } else {
+        min = info->tag_min[left] < info->tag_min[right] ? info->tag_min[left] : info->tag_min[right];
+    }
+    info->tag_min[node] = min + info->tag_shift[node];
+}
+
+// Recomputes every node above a leaf
+static inline void PS_tree_pull_path(scheduler_PS_t* info, size_t leaf)
+{
+    for (size_t node = leaf / 2; node > 0; node /= 2) {
+        PS_tree_pull(info, node);
+    }
+}
+
+// Puts a job with the given finish tag in the next arrival slot
+static void PS_tree_push(scheduler_PS_t* info, job_t* job, uint64_t tag)
+{
+    size_t leaf = info->slots + info->next_slot;
+    uint64_t shift = 0;
+    for (size_t node = leaf / 2; node > 0; node /= 2) {
+        shift += info->tag_shift[node];
+    }
+    // The leaf sits below the pending shifts of its ancestors
+    info->tag_min[leaf] = tag - shift;
+    info->tag_count[leaf] = 1;
+    info->slot_job[info->next_slot++] = job;
+    PS_tree_pull_path(info, leaf);
+}
+
+// Shifts the tags of the newest count jobs below a node by delta
+static void PS_tree_shift_newest(scheduler_PS_t* info, size_t node, uint64_t count, uint64_t delta)
+{
+    if (count == 0) {
+        return;
+    }
+    if (count >= info->tag_count[node]) {
+        info->tag_shift[node] += delta;
+        info->tag_min[node] += delta;
+        return;
+    }
+    size_t right = 2 * node + 1;
+    uint64_t right_count = info->tag_count[right];
+    if (count > right_count) {
+        PS_tree_shift_newest(info, right, right_count, delta);
+        PS_tree_shift_newest(info, right - 1, count - right_count, delta);
+    } else {
+        PS_tree_shift_newest(info, right, count, delta);
+    }
+    PS_tree_pull(info, node);
+}
+
+// Removes and returns the oldest job with the smallest finish tag
+static job_t* PS_tree_pop_min(scheduler_PS_t* info)
+{
+    size_t node = 1;
+    while (node < info->slots) {
+        // Children's tags are relative to the shift at this node
+        uint64_t min = info->tag_min[node] - info->tag_shift[node];
+        size_t left = 2 * node;
+        node = info->tag_count[left] > 0 && info->tag_min[left] == min ? left : left + 1;
+    }
+    info->tag_count[node] = 0;
+    PS_tree_pull_path(info, node);
+    return info->slot_job[node - info->slots];
+}
+
+// Copies the jobs below a node into a new tree in arrival order, applying the pending shifts
+static void PS_tree_copy(scheduler_PS_t* info, scheduler_PS_t* to, size_t node, uint64_t shift)
+{
+    if (info->tag_count[node] == 0) {
+        return;
+    }
+    if (node >= info->slots) {
+        PS_tree_push(to, info->slot_job[node - info->slots], info->tag_min[node] + shift);
+        return;
+    }
+    shift += info->tag_shift[node];
+    PS_tree_copy(info, to, 2 * node, shift);
+    PS_tree_copy(info, to, 2 * node + 1, shift);
+}
+
+// Moves the jobs into a new tree with free arrival slots for at least as many jobs again
+// Returns false on allocation failure
+static bool PS_tree_compact(scheduler_PS_t* info)
+{
+    size_t slots = PS_TREE_MIN_LEAVES;
+    while (slots < 2 * (info->num_jobs + 1)) {
+        slots *= 2;
+    }
+    scheduler_PS_t to;
+    if (!PS_tree_alloc(&to, slots)) {
+        return false;
+    }
+    PS_tree_copy(info, &to, 1, 0);
+    PS_tree_free(info);
+    info->tag_min = to.tag_min;
+    info->tag_shift = to.tag_shift;
+    info->tag_count = to.tag_count;
+    info->slot_job = to.slot_job;
+    info->slots = to.slots;
+    info->next_slot = to.next_slot;
+    return true;
+}
+
+// Returns the least remaining time of the jobs in the system
+static inline uint64_t PS_min_remaining(scheduler_PS_t* info)
+{
+    return info->tag_min[1] - info->virtual_time;
+}
+
 // Creates and returns scheduler specific info
 void* schedulerPSCreate()
 {
@@ -26,16 +189,15 @@ void* schedulerPSCreate()
     if (info == NULL) {
         return NULL;
     }
+    if (!PS_tree_alloc(info, PS_TREE_MIN_LEAVES)) {
+        free(info);
+        return NULL;
+    }
 
-    info->PS_list = list_create(NULL); 
-    info->time_to_run = 0;
-    info->remainder_time = 0; 
-    info->last_job_run_time = 0; 
-    info->num_jobs = 0; 
-    info->running_jobs = 0; 
-
-    info->completed_jobs = list_create(NULL); 
-    info->completed_job = NULL; 
+    info->virtual_time = 0;
+    info->remainder_time = 0;
+    info->last_job_run_time = 0;
+    info->num_jobs = 0;
     return info;
 }
 
@@ -44,8 +206,7 @@ void schedulerPSDestroy(void* schedulerInfo)
 {
     scheduler_PS_t* info = (scheduler_PS_t*)schedulerInfo;
 
-    list_destroy(info->PS_list); 
-    list_destroy(info->completed_jobs);
+    PS_tree_free(info);
     free(info);
 }
 
@@ -56,113 +217,42 @@ void schedulerPSDestroy(void* schedulerInfo)
 // currentTime - the current simulated time
 void schedulerPSScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
 {
-    /*
-     * Init some func vars
-     */
     scheduler_PS_t* info = (scheduler_PS_t*)schedulerInfo;
-    list_t* list = info->PS_list; 
-
-    /*
-     * Loop through PS_list, update each job's rem time 
-     * Set = (currentTime - last_job_run_time)/num_jobs = total time taken since last job / total num jobs
-     * EDIT: added cases when remainder > 0
-     */
-    list_node_t* curr_node = list_head(list); 
-    int i = 0;
-    while(curr_node != NULL)
-    {
-        uint64_t time_proccessed;
-        if(info->remainder_time == 0)
-        {
-            time_proccessed = ((currentTime - info->last_job_run_time)/info->num_jobs); 
-            jobSetRemainingTime(curr_node->data, jobGetRemainingTime(curr_node->data) - time_proccessed); 
-            curr_node = list_next(curr_node); 
-        }
-        else
-        {
-            //first part of list will already be accoutned for in rem time - do normally
-            if(i < info->remainder_time)
-            {
-                time_proccessed = ((currentTime - info->last_job_run_time)/info->num_jobs) + 1; 
-                i++; 
-            }
-            //items after index [remaining time] will need a + 1 so that work time is accoutned for
-            else
-            {
-                time_proccessed = ((currentTime - info->last_job_run_time)/info->num_jobs); 
-            }
-
-            jobSetRemainingTime(curr_node->data, jobGetRemainingTime(curr_node->data) - time_proccessed); 
-            curr_node = list_next(curr_node); 
-        }
-    }
-
-    /*
-     * Insert new job into PS_list and update num_jobs 
-     * Also init jobGetRemainingTime so that it is greater than 0
-     */
-    list_insert(list, job); 
-    (info->num_jobs)++; 
-    info->time_to_run = jobGetRemainingTime(job); 
+    uint64_t elapsed = currentTime - info->last_job_run_time;
 
     /*
-     * Loop trhough PS_list, update time_to_run to be equal to the least job rem time of all available jobs
+     * Compact the tree once the arrival slots run out, before charging any time,
+     * so the jobs carry on untouched if the job can't be given a slot
      */
-    curr_node = list_head(list); 
-    while(curr_node != NULL)
-    {
-        //set time_to_run to the shortest remaining job time
-        if(jobGetRemainingTime(curr_node->data) < info->time_to_run)
-        {
-            info->time_to_run = jobGetRemainingTime(curr_node->data);
-        }
-        curr_node = list_next(curr_node); 
+    if (info->next_slot == info->slots && !PS_tree_compact(info)) {
+        schedulerFail(scheduler);
+        return;
     }
 
     /*
-     * If jobs were previously running, cancel next completion
+     * Every job gets an equal share of the time since the last event
+     * The remainder left by the previous arrival goes one unit each to the newest jobs
      */
-    if(info->running_jobs == 1)
-    {
-        schedulerCancelNextCompletion(scheduler); 
+    if (info->num_jobs > 0) {
+        info->virtual_time += elapsed / info->num_jobs;
+        PS_tree_shift_newest(info, 1, info->remainder_time, (uint64_t)-1);
     }
 
     /*
-     * Schedule next job for completion time: currentTime + (time to run * num jobs) + remainder time
-     * Each job will run for time_to_run via processor sharing the remainder time accounts for new jobs that break the sequence
+     * Give the new job the next arrival slot
      */
-    info->remainder_time = (currentTime - info->last_job_run_time) % (info->num_jobs);
-    info->last_job_run_time = currentTime; 
-    info->running_jobs = 1; 
-    uint64_t time_to_completion = currentTime + (info->time_to_run * info->num_jobs); 
-    //uint64_t time_to_completion = currentTime + (info->time_to_run * info->num_jobs) + (info->remainder_time); 
-    schedulerScheduleNextCompletion(scheduler, time_to_completion);
+    PS_tree_push(info, job, jobGetRemainingTime(job) + info->virtual_time);
+    info->num_jobs++;
 
     /*
-     * Prints current PS_list
+     * Move the pending completion to when the job with the least remaining time finishes
+     * This arrival's remainder is handed out at the next arrival, or dropped by a completion
      */
-    printf("schedule job - curr list time: %ld\n", currentTime);
-    curr_node = list_head(list); 
-    while(curr_node)
-    {
-        printf("%ld, rem: %ld \n", jobGetId(list_data(curr_node)), jobGetRemainingTime(list_data(curr_node)));
-        curr_node = list_next(curr_node); 
-    }
-    printf("-----END LIST\n\n\n");
+    info->remainder_time = elapsed % info->num_jobs;
+    info->last_job_run_time = currentTime;
+    schedulerRescheduleNextCompletion(scheduler, currentTime + PS_min_remaining(info) * info->num_jobs);
 }
 
-
-
-
-
-
-
-
-
-
-
-
-
 // Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
 // schedulerInfo - scheduler specific info from create function
 // scheduler - used to call schedulerScheduleNextCompletion and schedulerCancelNextCompletion
@@ -170,107 +260,26 @@ void schedulerPSScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t*
 // Returns the job that is being completed
 job_t* schedulerPSCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
 {
-    /*
-     * Init some func vars
-     */
     scheduler_PS_t* info = (scheduler_PS_t*)schedulerInfo;
-    list_t* list = info->PS_list; 
-
-
-    //this sets time to run to the max time to run so the min can be found later
-    list_node_t* curr_node = list_head(list); 
-    while(curr_node != NULL)
-    {
-        if(jobGetRemainingTime(curr_node->data) > info->time_to_run)
-        {
-            info->time_to_run = jobGetRemainingTime(curr_node->data);
-        }
-        
-        curr_node = list_next(curr_node); 
-    }
-    /*
-     * Loop through PS_list, update each job's rem time 
-     * Set = (currentTime - last_job_run_time)/num_jobs = total time taken since last job / total num jobs
-     * 
-     * Loop trhough PS_list, get all completed jobs and insert them into completed_jobs
-     * 
-     * Also: update time_to_run to be equal to the least job rem time of all available jobs
-     */
-    curr_node = list_head(list); 
-    while(curr_node != NULL)
-    {
-        uint64_t time_proccessed = ((currentTime - info->last_job_run_time)/info->num_jobs); 
-        jobSetRemainingTime(curr_node->data, jobGetRemainingTime(curr_node->data) - time_proccessed); 
-
-        if(jobGetRemainingTime(curr_node->data) == 0 && list_find(info->completed_jobs, curr_node->data) == NULL)
-        {
-            list_insert(info->completed_jobs, curr_node->data);
-        }
-
-        //init info->time_to_run  
-        else if(jobGetRemainingTime(curr_node->data) < info->time_to_run && jobGetRemainingTime(curr_node->data) > 0)
-        {
-            info->time_to_run = jobGetRemainingTime(curr_node->data); 
-        }
-
-        curr_node = list_next(curr_node); 
-    }
-    
-    /*
-     * If completed_jobs, this func will collect the first completed job and return it, it will also set the next completion for the curr time 
-     * if more jobs need to be returned
-     */
-    if(list_head(info->completed_jobs) != NULL)
-    {
-        list_node_t* comnpleted_job_node = list_head(info->completed_jobs); 
-
-        info->completed_job = list_data(comnpleted_job_node); 
-
-        list_remove(list, list_find(list, info->completed_job)); 
-        info->num_jobs--;
-
-        list_remove(info->completed_jobs, comnpleted_job_node); 
-
-        if(list_head(info->completed_jobs) != NULL)
-        {
-            schedulerScheduleNextCompletion(scheduler, currentTime); 
-            //schedulerPSCompleteJob(schedulerInfo, scheduler, currentTime); 
-        }
-    }
-
-    /*
-     * Schedule next job for completion time: currentTime + (time to run * num jobs)
-     * Each job will run for time_to_run via processor sharing
-     * 
-     * If there are no jobs or the time to run = 0 then we will not run any jobs and update running jobs accordingly
-     */
-    uint64_t time_to_completion = currentTime + (info->time_to_run * info->num_jobs); 
-    info->last_job_run_time = currentTime; 
-    if(info->num_jobs != 0)
-    {
-        //run batch of jobs (running_jobs = 1)
-        info->running_jobs = 1;
-        info->remainder_time = 0;
-        schedulerScheduleNextCompletion(scheduler, time_to_completion);
-    }
-    else
-    {
-        //no jobs being run (running_jobs = -1)
-        info->running_jobs = -1; 
-        info->remainder_time = 0;
-    }
 
     /*
-     * Prints current PS_list
+     * Charge the time since the last event, which always divides evenly between the jobs
+     * Jobs that run out together complete oldest first, at the same time
      */
-    printf("complete job - curr list time: %ld\n", currentTime);
-    curr_node = list_head(list); 
-    while(curr_node)
-    {
-        printf("%ld, rem: %ld \n", jobGetId(list_data(curr_node)), jobGetRemainingTime(list_data(curr_node)));
-        curr_node = list_next(curr_node); 
+    info->virtual_time += (currentTime - info->last_job_run_time) / info->num_jobs;
+    assert(PS_min_remaining(info) == 0);
+    job_t* completed_job = PS_tree_pop_min(info);
+    jobSetRemainingTime(completed_job, 0);
+    info->num_jobs--;
+
+    info->remainder_time = 0;
+    info->last_job_run_time = currentTime;
+    if (info->num_jobs != 0) {
+        schedulerScheduleNextCompletion(scheduler, currentTime + PS_min_remaining(info) * info->num_jobs);
+    } else {
+        // Every slot is empty again, pending shifts only apply to jobs already gone
+        info->next_slot = 0;
     }
-    printf("-----END LIST\n\n\n");
 
-    return info->completed_job; 
+    return completed_job;
 }
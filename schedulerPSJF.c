@@ -2,29 +2,16 @@
 #include <stdlib.h>
 #include "scheduler.h"
 #include "job.h"
-#include "linked_list.h"
-
-#include<stdio.h>
+#include "job_heap.h"
 
 // PSJF scheduler info
+// Waiting jobs are kept in a heap keyed on job time, the running job is kept out of it
 typedef struct {
-    list_t* PSJF_list; 
+    job_heap_t PSJF_heap; 
     job_t* curr_job; 
     uint64_t last_working_time; 
 } scheduler_PSJF_t;
 
-int PSJF_compare(void* data1, void* data2)
-{
-    uint64_t job_time1 = jobGetRemainingTime(data1);
-    uint64_t job_time2 = jobGetRemainingTime(data2);
-    if (job_time1 == job_time2) {
-        return 0;
-    } else if (job_time1 > job_time2) {
-        return -1;
-    }
-    return 1; 
-}
-
 // Creates and returns scheduler specific info
 void* schedulerPSJFCreate()
 {
@@ -33,8 +20,9 @@ void* schedulerPSJFCreate()
         return NULL;
     }
 
-    info->PSJF_list = list_create(PSJF_compare); 
+    jobHeapInit(&info->PSJF_heap); 
     info->curr_job = NULL; 
+    info->last_working_time = 0; 
     return info;
 }
 
@@ -43,7 +31,7 @@ void schedulerPSJFDestroy(void* schedulerInfo)
 {
     scheduler_PSJF_t* info = (scheduler_PSJF_t*)schedulerInfo;
 
-    list_destroy(info->PSJF_list); 
+    jobHeapFree(&info->PSJF_heap); 
     free(info);
 }
 
@@ -55,33 +43,40 @@ void schedulerPSJFDestroy(void* schedulerInfo)
 void schedulerPSJFScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
 {
     scheduler_PSJF_t* info = (scheduler_PSJF_t*)schedulerInfo;
-    list_t* list = info->PSJF_list; 
-
-    list_insert(list, (void *)job); 
-
-    printf("Job being scheduled: %ld jobtime: %ld remtime:%ld\n", jobGetId(job), jobGetJobTime(job), jobGetRemainingTime(job)); 
-    //print_linked_list(info->PLCFS_list);
+    job_t* curr_job = info->curr_job; 
 
     //if no other job is being done, start the incoming job
-    if(list_next(list_head(list)) == NULL || info->curr_job == NULL)
+    if(curr_job == NULL)
     {
         uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
         info->curr_job = job; 
         info->last_working_time = currentTime; 
         schedulerScheduleNextCompletion(scheduler, job_completion_time);
+        return; 
     }
-    //otherwise there is currently a job being run. If job_time(new_job)<job_remaining_time(old_job) then we switch jobs
-    else if(jobGetRemainingTime(job) < jobGetRemainingTime(info->curr_job))
+
+    //charge the running job for the time it has run, so it is compared and queued by what is left
+    jobSetRemainingTime(curr_job, jobGetRemainingTime(curr_job) - (currentTime - info->last_working_time)); 
+    info->last_working_time = currentTime; 
+
+    //if the incoming job is shorter than the running job, it preempts it
+    if(jobHeapKey(job, jobGetJobTime(job)) < jobHeapKey(curr_job, jobGetJobTime(curr_job)))
     {
-        //update current jobs remaining time and cancel its completion 
-        jobSetRemainingTime(info->curr_job, jobGetRemainingTime(info->curr_job)-(currentTime - info->last_working_time)); 
-        schedulerCancelNextCompletion(scheduler); 
+        if(!jobHeapPushJob(&info->PSJF_heap, curr_job, jobGetJobTime(curr_job)))
+        {
+            //the running job carries on and the incoming job is lost
+            schedulerFail(scheduler);
+            return;
+        }
 
-        //start new job
+        //start new job, its completion replaces the preempted job's
         uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
         info->curr_job = job; 
-        info->last_working_time = currentTime; 
-        schedulerScheduleNextCompletion(scheduler, job_completion_time);
+        schedulerRescheduleNextCompletion(scheduler, job_completion_time);
+    }
+    else if(!jobHeapPushJob(&info->PSJF_heap, job, jobGetJobTime(job)))
+    {
+        schedulerFail(scheduler);
     }
 }
 
@@ -93,22 +88,16 @@ void schedulerPSJFScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t
 job_t* schedulerPSJFCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
 {
     scheduler_PSJF_t* info = (scheduler_PSJF_t*)schedulerInfo;
-    list_t* list = info->PSJF_list; 
     job_t* completed_job = info->curr_job; 
 
-    printf("Job being completed: %ld \n", jobGetId(completed_job)); 
-
-    list_remove(list, list_find(list, completed_job));
-    if(list_head(list) != NULL)
+    //resume the first waiting job, if any
+    info->curr_job = jobHeapPopJob(&info->PSJF_heap); 
+    if(info->curr_job != NULL)
     {
-        uint64_t job_completion_time = currentTime + jobGetRemainingTime(list_data(list_tail(list))); 
-        info->curr_job = list_data(list_tail(list)); 
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job); 
         info->last_working_time = currentTime; 
         schedulerScheduleNextCompletion(scheduler, job_completion_time); 
     }
-    else
-    {
-        info->curr_job = NULL; 
-    }
+
     return completed_job;
 }
@@ -2,26 +2,15 @@
 #include <stdlib.h>
 #include "scheduler.h"
 #include "job.h"
-#include "linked_list.h"
+#include "job_heap.h"
 
 // SJF scheduler info
+// Waiting jobs are kept in a heap keyed on job time, the running job is kept out of it
 typedef struct {
-    list_t* SJF_list; 
+    job_heap_t SJF_heap; 
     job_t* curr_job; 
 } scheduler_SJF_t;
 
-int SJF_compare(void* data1, void* data2)
-{
-    uint64_t job_time1 = jobGetJobTime(data1);
-    uint64_t job_time2 = jobGetJobTime(data2);
-    if (job_time1 == job_time2) {
-        return 0;
-    } else if (job_time1 > job_time2) {
-        return -1;
-    }
-    return 1; 
-}
-
 // Creates and returns scheduler specific info
 void* schedulerSJFCreate()
 {
@@ -30,7 +19,7 @@ void* schedulerSJFCreate()
         return NULL;
     }
 
-    info->SJF_list = list_create(SJF_compare); 
+    jobHeapInit(&info->SJF_heap); 
     info->curr_job = NULL; 
     return info;
 }
@@ -40,7 +29,7 @@ void schedulerSJFDestroy(void* schedulerInfo)
 {
     scheduler_SJF_t* info = (scheduler_SJF_t*)schedulerInfo;
 
-    list_destroy(info->SJF_list); 
+    jobHeapFree(&info->SJF_heap); 
     free(info);
 }
 
@@ -52,31 +41,20 @@ void schedulerSJFDestroy(void* schedulerInfo)
 void schedulerSJFScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
 {
     scheduler_SJF_t* info = (scheduler_SJF_t*)schedulerInfo;
-    list_t* list = info->SJF_list; 
 
-    list_insert(list, (void *)job); 
-    //if the inserted job is the only job in queue then we scheule its completion
-    if(list_next(list_head(list)) == NULL || info->curr_job == NULL)
+    //if no other job is being done, start the incoming job
+    if(info->curr_job == NULL)
     {
         uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
         info->curr_job = job; 
         schedulerScheduleNextCompletion(scheduler, job_completion_time); 
+        return; 
     }
-    //if a job with the same arrival time arrives, make sure the one with the shortest job is executed
-    /*
-    if(jobGetArrivalTime(job) == jobGetArrivalTime(info->curr_job))
+    //otherwise it waits its turn, shortest job first
+    if(!jobHeapPushJob(&info->SJF_heap, job, jobGetJobTime(job)))
     {
-        if(jobGetJobTime(job) < jobGetJobTime(info->curr_job))
-        {
-            //cancel curr job, its not the shortest
-            schedulerCancelNextCompletion(scheduler); 
-            //start job with same arrival time but shorter job time
-            uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
-            info->curr_job = job; 
-            schedulerScheduleNextCompletion(scheduler, job_completion_time); 
-        }
+        schedulerFail(scheduler);
     }
-    */
 }
 
 // Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
@@ -87,20 +65,15 @@ void schedulerSJFScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t*
 job_t* schedulerSJFCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
 {
     scheduler_SJF_t* info = (scheduler_SJF_t*)schedulerInfo;
-    list_t* list = info->SJF_list; 
     job_t* completed_job = info->curr_job; 
 
-    list_remove(list, list_find(list, completed_job)); 
-    if(list_tail(list) != NULL)
+    //start the shortest waiting job, if any
+    info->curr_job = jobHeapPopJob(&info->SJF_heap); 
+    if(info->curr_job != NULL)
     {
-        uint64_t job_completion_time = currentTime + jobGetRemainingTime(list_data(list_tail(list))); 
-        info->curr_job = list_data(list_tail(list)); 
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job); 
         schedulerScheduleNextCompletion(scheduler, job_completion_time); 
     }
-    else
-    {
-        info->curr_job = NULL; 
-    }
 
     return completed_job;
 }
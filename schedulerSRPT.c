@@ -2,30 +2,16 @@
 #include <stdlib.h>
 #include "scheduler.h"
 #include "job.h"
-#include "linked_list.h"
-
-#include "stdio.h"
+#include "job_heap.h"
 
 // SRPT scheduler info
+// Waiting jobs are kept in a heap keyed on remaining time, the running job is kept out of it
 typedef struct {
-    list_t* SRPT_list; 
+    job_heap_t SRPT_heap; 
     job_t* curr_job; 
     uint64_t last_working_time; 
 } scheduler_SRPT_t;
 
-int SRPT_compare(void* data1, void* data2)
-{
-    uint64_t proc_time1 = jobGetRemainingTime(data1);
-    uint64_t proc_time2 = jobGetRemainingTime(data2);
-    if (proc_time1 == proc_time2) {
-        return 0;
-    } else if (proc_time1 > proc_time2) {
-        return -1;
-    }
-    return 1; 
-}
-
-
 // Creates and returns scheduler specific info
 void* schedulerSRPTCreate()
 {
@@ -34,8 +20,9 @@ void* schedulerSRPTCreate()
         return NULL;
     }
 
-    info->SRPT_list = list_create(SRPT_compare); 
+    jobHeapInit(&info->SRPT_heap); 
     info->curr_job = NULL; 
+    info->last_working_time = 0; 
     return info;
 }
 
@@ -44,7 +31,7 @@ void schedulerSRPTDestroy(void* schedulerInfo)
 {
     scheduler_SRPT_t* info = (scheduler_SRPT_t*)schedulerInfo;
 
-    list_destroy(info->SRPT_list); 
+    jobHeapFree(&info->SRPT_heap); 
     free(info);
 }
 
@@ -56,42 +43,41 @@ void schedulerSRPTDestroy(void* schedulerInfo)
 void schedulerSRPTScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t* job, uint64_t currentTime)
 {
     scheduler_SRPT_t* info = (scheduler_SRPT_t*)schedulerInfo;
-    list_t* list = info->SRPT_list; 
-
-    list_insert(list, (void *)job); 
+    job_t* curr_job = info->curr_job; 
 
     //if no other job is being done, start the incoming job
-    if(list_next(list_head(list)) == NULL || info->curr_job == NULL)
+    if(curr_job == NULL)
     {
         uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
         info->curr_job = job; 
         info->last_working_time = currentTime; 
         schedulerScheduleNextCompletion(scheduler, job_completion_time);
+        return; 
     }
-    //otherwise there is currently a job being run. If job_time(new_job)<job_remaining_time(old_job) then we switch jobs
-    else if(jobGetRemainingTime(job) < jobGetRemainingTime(info->curr_job))
-    {
-        //update current jobs remaining time and cancel its completion 
-        jobSetRemainingTime(info->curr_job, jobGetRemainingTime(info->curr_job)-(currentTime - info->last_working_time)); 
-        schedulerCancelNextCompletion(scheduler); 
-        list_remove(list, list_find(list, (void *)job));
-        list_insert(list, (void *)job); 
 
-        //start new job
+    //charge the running job for the time it has run, so it is compared and queued by what is left
+    jobSetRemainingTime(curr_job, jobGetRemainingTime(curr_job) - (currentTime - info->last_working_time)); 
+    info->last_working_time = currentTime; 
+
+    //if the incoming job is closer to done than the running job, it preempts it
+    if(jobHeapKey(job, jobGetRemainingTime(job)) < jobHeapKey(curr_job, jobGetRemainingTime(curr_job)))
+    {
+        if(!jobHeapPushJob(&info->SRPT_heap, curr_job, jobGetRemainingTime(curr_job)))
+        {
+            //the running job carries on and the incoming job is lost
+            schedulerFail(scheduler);
+            return;
+        }
+
+        //start new job, its completion replaces the preempted job's
         uint64_t job_completion_time = currentTime + jobGetRemainingTime(job); 
         info->curr_job = job; 
-        info->last_working_time = currentTime; 
-        schedulerScheduleNextCompletion(scheduler, job_completion_time);
+        schedulerRescheduleNextCompletion(scheduler, job_completion_time);
     }
-
-    printf("schedule job - curr list time: %ld\n", currentTime);
-    list_node_t* curr_node = list_head(list); 
-    while(curr_node)
+    else if(!jobHeapPushJob(&info->SRPT_heap, job, jobGetRemainingTime(job)))
     {
-        printf("%ld, rem: %ld \n", jobGetId(list_data(curr_node)), jobGetRemainingTime(list_data(curr_node)));
-        curr_node = list_next(curr_node); 
+        schedulerFail(scheduler);
     }
-    printf("-----END LIST\n\n\n");
 }
 
 // Called to complete a job in response to an earlier call to schedulerScheduleNextCompletion
@@ -102,31 +88,16 @@ void schedulerSRPTScheduleJob(void* schedulerInfo, scheduler_t* scheduler, job_t
 job_t* schedulerSRPTCompleteJob(void* schedulerInfo, scheduler_t* scheduler, uint64_t currentTime)
 {
     scheduler_SRPT_t* info = (scheduler_SRPT_t*)schedulerInfo;
-    list_t* list = info->SRPT_list; 
     job_t* completed_job = info->curr_job; 
 
-    list_remove(list, list_find(list, completed_job)); 
-
-    if(list_head(list) != NULL)
+    //resume the first waiting job, if any
+    info->curr_job = jobHeapPopJob(&info->SRPT_heap); 
+    if(info->curr_job != NULL)
     {
-        uint64_t job_completion_time = currentTime + jobGetRemainingTime(list_data(list_tail(list))); 
-        info->curr_job = list_data(list_tail(list)); 
+        uint64_t job_completion_time = currentTime + jobGetRemainingTime(info->curr_job); 
         info->last_working_time = currentTime; 
         schedulerScheduleNextCompletion(scheduler, job_completion_time); 
     }
-    else
-    {
-        info->curr_job = NULL; 
-    }
-
-    printf("complete job - curr list time: %ld\n", currentTime);
-    list_node_t* curr_node = list_head(list); 
-    while(curr_node)
-    {
-        printf("%ld, rem: %ld \n", jobGetId(list_data(curr_node)), jobGetRemainingTime(list_data(curr_node)));
-        curr_node = list_next(curr_node); 
-    }
-    printf("-----END LIST\n\n\n");
 
     return completed_job;
 }
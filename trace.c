@@ -2,59 +2,470 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <assert.h>
 #include "trace.h"
 #include "simulator.h"
 #include "scheduler.h"
 #include "job.h"
 
-// Run a trace
-// traceFilename - path to trace file
-// outFilename - path to output file
+// Fill in the default options
+// options - options to fill in
+void traceOptionsDefault(trace_options_t* options)
+{
+    options->outputOrder = TRACE_OUTPUT_SORTED;
+    options->sortMemory = TRACE_DEFAULT_SORT_MEMORY;
+    options->tempDir = NULL;
+    options->pipelined = false;
+    options->parseThreads = 0;
+}
+
+// Run a trace with the default options
+// traceFilename - path to trace file, "-" for standard input
+// outFilename - path to output file, "-" for standard output
 // scheduler - queue scheduler to evaluate
 // Returns true on success, false otherwise
 bool traceRun(const char* traceFilename, const char* outFilename, const char* schedulerName)
 {
-    trace_t* trace = malloc(sizeof(trace_t));
-    if (trace == NULL) {
+    return traceRunStats(traceFilename, outFilename, schedulerName, NULL, NULL);
+}
+
+// Close the input of a trace and free it
+// trace - trace with either reader or workload set
+static void traceFree(trace_t* trace)
+{
+    if (trace->chunks != NULL) {
+        traceChunksDestroy(trace->chunks);
+    }
+    if (trace->reader != NULL) {
+        traceReaderClose(trace->reader);
+    }
+    if (trace->workload != NULL) {
+        workloadDestroy(trace->workload);
+    }
+    free(trace);
+}
+
+// Close the output file and sorter of a trace
+// Returns false if any write failed
+static bool traceCloseOutput(trace_t* trace)
+{
+    if (trace->sorter != NULL) {
+        completionSorterDestroy(trace->sorter);
+    }
+    return traceWriterClose(trace->writer);
+}
+
+// Read the next job from the trace file or workload
+// Returns false at the end of the input
+static bool traceReadJob(trace_t* trace, uint64_t* id, uint64_t* arrivalTime, uint64_t* jobTime)
+{
+    if (trace->decoded != NULL) {
+        if (trace->nextRecord == trace->decoded->count) {
+            return false;
+        }
+        const trace_record_t* record = &trace->decoded->records[trace->nextRecord++];
+        *id = record->id;
+        *arrivalTime = record->time;
+        *jobTime = record->jobTime;
+        return true;
+    }
+    if (trace->workload != NULL) {
+        return workloadNext(trace->workload, id, arrivalTime, jobTime);
+    }
+    if (trace->chunks != NULL) {
+        if (!traceChunksNext(trace->chunks, id, arrivalTime, jobTime)) {
+            assert(traceChunksEof(trace->chunks));
+            return false;
+        }
+        return true;
+    }
+    if (!traceReaderNext(trace->reader, id, arrivalTime, jobTime)) {
+        assert(traceReaderEof(trace->reader));
         return false;
     }
-    trace->traceFile = fopen(traceFilename, "r");
-    if (trace->traceFile == NULL) {
-        printf("Invalid trace file: %s\n", traceFilename);
-        free(trace);
+    return true;
+}
+
+// Pass a completion on to the sorter or straight to the output file
+static inline void traceOutputCompletion(trace_t* trace, uint64_t id, uint64_t time)
+{
+    if (trace->sorter != NULL) {
+        completionSorterAdd(trace->sorter, id, time);
+    } else {
+        traceWriterCompletion(trace->writer, id, time);
+    }
+}
+
+// Parser thread, decodes the input into the arrivals ring
+// t - trace
+static void* traceParserThread(void* t)
+{
+    trace_t* trace = (trace_t*)t;
+    trace_record_t record;
+    while (traceReadJob(trace, &record.id, &record.time, &record.jobTime)) {
+        traceRingPush(trace->arrivals, &record);
+    }
+    traceRingClose(trace->arrivals);
+    return NULL;
+}
+
+// Writer thread, drains the completions ring into the sorter or output file
+// t - trace
+static void* traceWriterThread(void* t)
+{
+    trace_t* trace = (trace_t*)t;
+    trace_record_t record;
+    while (traceRingPop(trace->completions, &record)) {
+        traceOutputCompletion(trace, record.id, record.time);
+    }
+    return NULL;
+}
+
+// Start the parser and writer threads
+// The simulator stays on the calling thread, so the run is as deterministic as a serial one
+// Returns false if a ring or thread can't be created
+static bool traceStartPipeline(trace_t* trace)
+{
+    trace->arrivals = traceRingCreate();
+    if (trace->arrivals == NULL) {
         return false;
     }
-    trace->outFile = fopen(outFilename, "w");
-    if (trace->outFile == NULL) {
+    trace->completions = traceRingCreate();
+    if (trace->completions == NULL) {
+        traceRingDestroy(trace->arrivals);
+        trace->arrivals = NULL;
+        return false;
+    }
+    // The writer only ever waits on the completions ring, so it can always be stopped
+    if (pthread_create(&trace->writerThread, NULL, traceWriterThread, trace) != 0) {
+        traceRingDestroy(trace->completions);
+        traceRingDestroy(trace->arrivals);
+        trace->completions = NULL;
+        trace->arrivals = NULL;
+        return false;
+    }
+    if (pthread_create(&trace->parserThread, NULL, traceParserThread, trace) != 0) {
+        traceRingClose(trace->completions);
+        pthread_join(trace->writerThread, NULL);
+        traceRingDestroy(trace->completions);
+        traceRingDestroy(trace->arrivals);
+        trace->completions = NULL;
+        trace->arrivals = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Wait for the parser and writer threads once the simulation has finished
+static void traceStopPipeline(trace_t* trace)
+{
+    // The simulator only stops once the parser has closed the arrivals ring
+    pthread_join(trace->parserThread, NULL);
+    traceRingClose(trace->completions);
+    pthread_join(trace->writerThread, NULL);
+    traceRingDestroy(trace->completions);
+    traceRingDestroy(trace->arrivals);
+    trace->completions = NULL;
+    trace->arrivals = NULL;
+}
+
+// Run a trace whose input is already open
+// trace - trace with either reader or workload set, freed on return
+// outFilename - path to output file, "-" for standard output
+// scheduler - queue scheduler to evaluate
+// options - settings for the run, NULL for the defaults
+// stats - filled in on success, may be NULL
+// Returns true on success, false otherwise
+static bool traceRunInput(trace_t* trace, const char* outFilename, const char* schedulerName, const trace_options_t* options, trace_stats_t* stats)
+{
+    trace_options_t defaults;
+    if (options == NULL) {
+        traceOptionsDefault(&defaults);
+        options = &defaults;
+    }
+    trace->writer = traceWriterOpen(outFilename);
+    if (trace->writer == NULL) {
         printf("Invalid output file: %s\n", outFilename);
-        fclose(trace->traceFile);
-        free(trace);
+        traceFree(trace);
         return false;
     }
-    trace->sim = simulatorCreate();
+    trace->sorter = NULL;
+    if (options->outputOrder == TRACE_OUTPUT_SORTED) {
+        const char* tempDir = options->tempDir;
+        if (tempDir == NULL) {
+            tempDir = getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp";
+        }
+        trace->sorter = completionSorterCreate(options->sortMemory, tempDir);
+        if (trace->sorter == NULL) {
+            traceWriterClose(trace->writer);
+            traceFree(trace);
+            return false;
+        }
+    }
+    trace->jobs = jobStoreCreate();
+    if (trace->jobs == NULL) {
+        traceCloseOutput(trace);
+        traceFree(trace);
+        return false;
+    }
+    trace->sim = simulatorCreate(EVENT_QUEUE_HEAP);
     if (trace->sim == NULL) {
-        fclose(trace->outFile);
-        fclose(trace->traceFile);
-        free(trace);
+        jobStoreDestroy(trace->jobs);
+        traceCloseOutput(trace);
+        traceFree(trace);
         return false;
     }
     trace->scheduler = schedulerCreate(schedulerName, trace->sim, traceCompletionCallback, trace);
     if (trace->scheduler == NULL) {
         simulatorDestroy(trace->sim);
-        fclose(trace->outFile);
-        fclose(trace->traceFile);
-        free(trace);
+        jobStoreDestroy(trace->jobs);
+        traceCloseOutput(trace);
+        traceFree(trace);
+        return false;
+    }
+    trace->jobCount = 0;
+    trace->arrivals = NULL;
+    trace->completions = NULL;
+    if (options->pipelined && !traceStartPipeline(trace)) {
+        schedulerDestroy(trace->scheduler);
+        simulatorDestroy(trace->sim);
+        jobStoreDestroy(trace->jobs);
+        traceCloseOutput(trace);
+        traceFree(trace);
         return false;
     }
     traceScheduleNextArrival(trace);
     simulatorRun(trace->sim);
+    if (trace->arrivals != NULL) {
+        traceStopPipeline(trace);
+    }
+    if (stats != NULL) {
+        stats->jobs = trace->jobCount;
+        stats->events = simulatorEventCount(trace->sim);
+    }
+    bool ok = true;
+    if (schedulerFailed(trace->scheduler)) {
+        printf("Error scheduling jobs: %s\n", schedulerName);
+        ok = false;
+    }
     schedulerDestroy(trace->scheduler);
     simulatorDestroy(trace->sim);
-    fclose(trace->outFile);
-    fclose(trace->traceFile);
-    free(trace);
-    return true;
+    jobStoreDestroy(trace->jobs);
+    if (trace->sorter != NULL && !completionSorterWrite(trace->sorter, trace->writer)) {
+        printf("Error sorting output file: %s\n", outFilename);
+        ok = false;
+    }
+    if (!traceCloseOutput(trace) && ok) {
+        printf("Error writing output file: %s\n", outFilename);
+        ok = false;
+    }
+    traceFree(trace);
+    return ok;
+}
+
+// Run a trace and collect its counters
+// traceFilename - path to trace file, "-" for standard input
+// outFilename - path to output file, "-" for standard output
+// scheduler - queue scheduler to evaluate
+// options - settings for the run, NULL for the defaults
+// stats - filled in on success, may be NULL
+// Returns true on success, false otherwise
+bool traceRunStats(const char* traceFilename, const char* outFilename, const char* schedulerName, const trace_options_t* options, trace_stats_t* stats)
+{
+    trace_t* trace = malloc(sizeof(trace_t));
+    if (trace == NULL) {
+        return false;
+    }
+    trace->workload = NULL;
+    trace->decoded = NULL;
+    trace->chunks = NULL;
+    trace->reader = traceReaderOpen(traceFilename);
+    if (trace->reader == NULL) {
+        printf("Invalid trace file: %s\n", traceFilename);
+        free(trace);
+        return false;
+    }
+    // Traces that can't be split into chunks are parsed serially
+    if (options != NULL && options->parseThreads > 0) {
+        trace->chunks = traceChunksCreate(trace->reader, options->parseThreads);
+    }
+    return traceRunInput(trace, outFilename, schedulerName, options, stats);
+}
+
+// Run a generated workload without writing it to a trace file
+// config - workload to generate
+// outFilename - path to output file, "-" for standard output
+// scheduler - queue scheduler to evaluate
+// options - settings for the run, NULL for the defaults
+// stats - filled in on success, may be NULL
+// Returns true on success, false otherwise
+bool traceRunWorkload(const workload_config_t* config, const char* outFilename, const char* schedulerName, const trace_options_t* options, trace_stats_t* stats)
+{
+    trace_t* trace = malloc(sizeof(trace_t));
+    if (trace == NULL) {
+        return false;
+    }
+    trace->reader = NULL;
+    trace->chunks = NULL;
+    trace->decoded = NULL;
+    trace->workload = workloadCreate(config);
+    if (trace->workload == NULL) {
+        printf("Invalid workload\n");
+        free(trace);
+        return false;
+    }
+    return traceRunInput(trace, outFilename, schedulerName, options, stats);
+}
+
+// Decode a whole trace file into memory
+// traceFilename - path to trace file, "-" for standard input
+// Returns NULL if the file can't be opened or on allocation failure
+trace_decoded_t* traceDecode(const char* traceFilename)
+{
+    trace_decoded_t* decoded = malloc(sizeof(trace_decoded_t));
+    if (decoded == NULL) {
+        return NULL;
+    }
+    decoded->count = 0;
+    decoded->capacity = TRACE_DECODE_INITIAL_CAPACITY;
+    decoded->records = malloc(decoded->capacity * sizeof(trace_record_t));
+    if (decoded->records == NULL) {
+        free(decoded);
+        return NULL;
+    }
+    trace_reader_t* reader = traceReaderOpen(traceFilename);
+    if (reader == NULL) {
+        printf("Invalid trace file: %s\n", traceFilename);
+        free(decoded->records);
+        free(decoded);
+        return NULL;
+    }
+    trace_record_t record;
+    while (traceReaderNext(reader, &record.id, &record.time, &record.jobTime)) {
+        if (decoded->count == decoded->capacity) {
+            trace_record_t* records = realloc(decoded->records, 2 * decoded->capacity * sizeof(trace_record_t));
+            if (records == NULL) {
+                traceReaderClose(reader);
+                traceDecodedDestroy(decoded);
+                return NULL;
+            }
+            decoded->records = records;
+            decoded->capacity *= 2;
+        }
+        decoded->records[decoded->count++] = record;
+    }
+    assert(traceReaderEof(reader));
+    traceReaderClose(reader);
+    return decoded;
+}
+
+// Destroy a decoded trace
+void traceDecodedDestroy(trace_decoded_t* decoded)
+{
+    free(decoded->records);
+    free(decoded);
+}
+
+// Run a decoded trace
+// decoded - decoded trace, left unchanged so other threads may run it at the same time
+// outFilename - path to output file, "-" for standard output
+// scheduler - queue scheduler to evaluate
+// options - settings for the run, NULL for the defaults
+// stats - filled in on success, may be NULL
+// Returns true on success, false otherwise
+bool traceRunDecoded(const trace_decoded_t* decoded, const char* outFilename, const char* schedulerName, const trace_options_t* options, trace_stats_t* stats)
+{
+    trace_t* trace = malloc(sizeof(trace_t));
+    if (trace == NULL) {
+        return false;
+    }
+    trace->reader = NULL;
+    trace->chunks = NULL;
+    trace->workload = NULL;
+    trace->decoded = decoded;
+    trace->nextRecord = 0;
+    return traceRunInput(trace, outFilename, schedulerName, options, stats);
+}
+
+// Sweep thread, runs schedulers until none are left
+// s - sweep
+static void* traceSweepThread(void* s)
+{
+    trace_sweep_t* sweep = (trace_sweep_t*)s;
+    size_t index;
+    while ((index = atomic_fetch_add(&sweep->next, 1)) < sweep->count) {
+        const char* schedulerName = sweep->schedulerNames[index];
+        size_t size = strlen(sweep->outPrefix) + strlen(schedulerName) + 2;
+        char* outFilename = malloc(size);
+        if (outFilename == NULL) {
+            atomic_store(&sweep->ok, false);
+            continue;
+        }
+        snprintf(outFilename, size, "%s.%s", sweep->outPrefix, schedulerName);
+        trace_stats_t* stats = sweep->stats != NULL ? &sweep->stats[index] : NULL;
+        if (!traceRunDecoded(sweep->decoded, outFilename, schedulerName, sweep->options, stats)) {
+            atomic_store(&sweep->ok, false);
+        }
+        free(outFilename);
+    }
+    return NULL;
+}
+
+// Run several schedulers over one trace, decoding it only once
+// traceFilename - path to trace file, "-" for standard input
+// outPrefix - output file path, extended with a dot and the scheduler name, not "-"
+// schedulerNames - queue schedulers to evaluate, each listed once
+// count - number of schedulers
+// options - settings for each run, NULL for the defaults
+// threads - most schedulers to run at once, the calling thread counts as one
+// stats - filled in for each scheduler on success, may be NULL
+// Returns true if every run succeeded, false if any failed or the arguments are invalid
+bool traceRunSweep(const char* traceFilename, const char* outPrefix, const char* const* schedulerNames, size_t count, const trace_options_t* options, unsigned threads, trace_stats_t* stats)
+{
+    // Every scheduler writes its own file, so none may share standard output or a file name
+    if (strcmp(outPrefix, TRACE_WRITER_STDOUT) == 0) {
+        printf("Standard output can't be the output of a sweep\n");
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < i; j++) {
+            if (strcmp(schedulerNames[i], schedulerNames[j]) == 0) {
+                printf("Scheduler listed twice in a sweep: %s\n", schedulerNames[i]);
+                return false;
+            }
+        }
+    }
+    trace_decoded_t* decoded = traceDecode(traceFilename);
+    if (decoded == NULL) {
+        return false;
+    }
+    trace_sweep_t sweep;
+    sweep.decoded = decoded;
+    sweep.outPrefix = outPrefix;
+    sweep.schedulerNames = schedulerNames;
+    sweep.count = count;
+    sweep.options = options;
+    sweep.stats = stats;
+    atomic_init(&sweep.next, 0);
+    atomic_init(&sweep.ok, true);
+    size_t workers = threads < count ? threads : count;
+    size_t helpers = workers > 1 ? workers - 1 : 0;
+    pthread_t* helperThreads = helpers > 0 ? malloc(helpers * sizeof(pthread_t)) : NULL;
+    size_t started = 0;
+    if (helperThreads != NULL) {
+        // A helper that fails to start just leaves more schedulers for the others
+        while (started < helpers && pthread_create(&helperThreads[started], NULL, traceSweepThread, &sweep) == 0) {
+            started++;
+        }
+    }
+    traceSweepThread(&sweep);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(helperThreads[i], NULL);
+    }
+    free(helperThreads);
+    traceDecodedDestroy(decoded);
+    return atomic_load(&sweep.ok);
 }
 
 // Schedule the next arrival in the trace
@@ -64,13 +475,21 @@ void traceScheduleNextArrival(trace_t* trace)
     uint64_t id;
     uint64_t arrivalTime;
     uint64_t jobTime;
-    if (fscanf(trace->traceFile, "%" SCNu64 ", %" SCNu64 ", %" SCNu64, &id, &arrivalTime, &jobTime) != 3) {
-        assert(feof(trace->traceFile));
+    if (trace->arrivals != NULL) {
+        trace_record_t record;
+        if (!traceRingPop(trace->arrivals, &record)) {
+            return;
+        }
+        id = record.id;
+        arrivalTime = record.time;
+        jobTime = record.jobTime;
+    } else if (!traceReadJob(trace, &id, &arrivalTime, &jobTime)) {
         return;
     }
-    trace->currentJob = jobCreate(arrivalTime, jobTime, id);
+    trace->currentJob = jobStoreCreateJob(trace->jobs, arrivalTime, jobTime, id);
     assert(trace->currentJob);
-    list_node_t* eventRef = simulatorSchedule(trace->sim, jobGetArrivalTime(trace->currentJob), EVENT_ARRIVAL, traceArrivalCallback, trace);
+    trace->jobCount++;
+    event_t* eventRef = simulatorScheduleArrival(trace->sim, jobGetArrivalTime(trace->currentJob), traceArrivalCallback, trace);
     assert(eventRef);
 }
 
@@ -88,6 +507,11 @@ void traceArrivalCallback(void* t)
 void traceCompletionCallback(void* t, job_t* job)
 {
     trace_t* trace = (trace_t*)t;
-    fprintf(trace->outFile, "%" PRIu64 ", %" PRIu64 "\n", jobGetId(job), simulatorSimTime(trace->sim));
-    jobDestroy(job);
+    if (trace->completions != NULL) {
+        trace_record_t record = { jobGetId(job), simulatorSimTime(trace->sim), 0 };
+        traceRingPush(trace->completions, &record);
+    } else {
+        traceOutputCompletion(trace, jobGetId(job), simulatorSimTime(trace->sim));
+    }
+    jobStoreReleaseJob(trace->jobs, job);
 }
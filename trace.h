@@ -3,25 +3,143 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
 #include "simulator.h"
 #include "scheduler.h"
 #include "job.h"
+#include "job_store.h"
+#include "trace_reader.h"
+#include "trace_chunks.h"
+#include "trace_writer.h"
+#include "completion_sort.h"
+#include "trace_ring.h"
+#include "workload.h"
 
+// Trace decoded into memory once, so several runs can share it without parsing it again
+// Runs only read the records, so any number of threads may run the same decoded trace
 typedef struct {
-    FILE* traceFile; // trace file
-    FILE* outFile; // output file
+    trace_record_t* records; // jobs in trace order
+    size_t count; // number of jobs
+    size_t capacity; // space in records
+} trace_decoded_t;
+
+typedef struct {
+    trace_reader_t* reader; // trace file reader, NULL unless jobs come from a trace file
+    trace_chunks_t* chunks; // parses the reader's trace on worker threads, NULL when the reader parses it
+    workload_t* workload; // workload generator, NULL unless jobs come from a workload
+    const trace_decoded_t* decoded; // decoded trace, NULL unless jobs come from a decoded trace
+    size_t nextRecord; // next job to run from the decoded trace
+    trace_writer_t* writer; // output file writer
+    completion_sorter_t* sorter; // completions waiting to be written in id order, NULL in completion order
     simulator_t* sim; // simulator
     scheduler_t* scheduler; // scheduler
+    job_store_t* jobs; // storage for the jobs in the system
     job_t* currentJob; // current job
+    uint64_t jobCount; // jobs read from the trace so far
+    trace_ring_t* arrivals; // jobs decoded by the parser thread, NULL unless pipelined
+    trace_ring_t* completions; // completions for the writer thread, NULL unless pipelined
+    pthread_t parserThread; // decodes the input into arrivals
+    pthread_t writerThread; // drains completions into the sorter or output file
 } trace_t;
 
-// Run a trace
-// traceFilename - path to trace file
-// outFilename - path to output file
+// Order of the lines in the output file
+typedef enum {
+    TRACE_OUTPUT_SORTED, // by job id, as "sort -n" would order them
+    TRACE_OUTPUT_COMPLETION_ORDER // streamed out as jobs complete
+} trace_output_order_t;
+
+#define TRACE_DEFAULT_SORT_MEMORY ((size_t)1 << 30) // bytes used to sort the output before spilling to disk
+
+// Settings for running a trace
+typedef struct {
+    trace_output_order_t outputOrder; // order of the output lines
+    size_t sortMemory; // bytes used to sort the output before spilling runs to disk, 0 for no limit
+    const char* tempDir; // directory for sort runs, NULL for $TMPDIR or /tmp
+    bool pipelined; // parse the input and write the output on their own threads
+    unsigned parseThreads; // workers parsing a mapped text trace in chunks, 0 to parse it serially
+} trace_options_t;
+
+// Counters collected while running a trace
+typedef struct {
+    uint64_t jobs; // jobs read from the trace
+    uint64_t events; // events dispatched by the simulator
+} trace_stats_t;
+
+#define TRACE_DECODE_INITIAL_CAPACITY 4096 // jobs held before the first resize while decoding
+
+// Schedulers shared out between the threads of a sweep
+typedef struct {
+    const trace_decoded_t* decoded; // trace every scheduler runs
+    const char* outPrefix; // output file path before the scheduler name
+    const char* const* schedulerNames; // queue schedulers to evaluate
+    size_t count; // number of schedulers
+    const trace_options_t* options; // settings for each run
+    trace_stats_t* stats; // counters for each scheduler, may be NULL
+    _Atomic size_t next; // next scheduler for a thread to take
+    _Atomic bool ok; // cleared once any run fails
+} trace_sweep_t;
+
+// Fill in the default options
+// Output is sorted by job id in TRACE_DEFAULT_SORT_MEMORY, spilling to $TMPDIR or /tmp,
+// and the whole run, parsing included, happens on the calling thread
+// options - options to fill in
+void traceOptionsDefault(trace_options_t* options);
+
+// Run a trace with the default options
+// traceFilename - path to trace file, "-" for standard input
+// outFilename - path to output file, "-" for standard output
 // scheduler - queue scheduler to evaluate
 // Returns true on success, false otherwise
 bool traceRun(const char* traceFilename, const char* outFilename, const char* schedulerName);
 
+// Run a trace and collect its counters
+// traceFilename - path to trace file, "-" for standard input
+// outFilename - path to output file, "-" for standard output
+// scheduler - queue scheduler to evaluate
+// options - settings for the run, NULL for the defaults
+// stats - filled in on success, may be NULL
+// Returns true on success, false otherwise
+bool traceRunStats(const char* traceFilename, const char* outFilename, const char* schedulerName, const trace_options_t* options, trace_stats_t* stats);
+
+// Run a generated workload without writing it to a trace file
+// config - workload to generate
+// outFilename - path to output file, "-" for standard output
+// scheduler - queue scheduler to evaluate
+// options - settings for the run, NULL for the defaults
+// stats - filled in on success, may be NULL
+// Returns true on success, false otherwise
+bool traceRunWorkload(const workload_config_t* config, const char* outFilename, const char* schedulerName, const trace_options_t* options, trace_stats_t* stats);
+
+// Decode a whole trace file into memory
+// traceFilename - path to trace file, "-" for standard input
+// Returns NULL if the file can't be opened or on allocation failure
+trace_decoded_t* traceDecode(const char* traceFilename);
+
+// Destroy a decoded trace
+void traceDecodedDestroy(trace_decoded_t* decoded);
+
+// Run a decoded trace
+// decoded - decoded trace, left unchanged so other threads may run it at the same time
+// outFilename - path to output file, "-" for standard output
+// scheduler - queue scheduler to evaluate
+// options - settings for the run, NULL for the defaults
+// stats - filled in on success, may be NULL
+// Returns true on success, false otherwise
+bool traceRunDecoded(const trace_decoded_t* decoded, const char* outFilename, const char* schedulerName, const trace_options_t* options, trace_stats_t* stats);
+
+// Run several schedulers over one trace, decoding it only once
+// Each scheduler gets its own simulator and jobs and writes to outPrefix.SCHEDULER
+// traceFilename - path to trace file, "-" for standard input
+// outPrefix - output file path, extended with a dot and the scheduler name, not "-"
+// schedulerNames - queue schedulers to evaluate, each listed once
+// count - number of schedulers
+// options - settings for each run, NULL for the defaults
+// threads - most schedulers to run at once, the calling thread counts as one
+// stats - filled in for each scheduler on success, may be NULL
+// Returns true if every run succeeded, false if any failed or the arguments are invalid
+bool traceRunSweep(const char* traceFilename, const char* outPrefix, const char* const* schedulerNames, size_t count, const trace_options_t* options, unsigned threads, trace_stats_t* stats);
+
 // Schedule the next arrival in the trace
 // trace - trace
 void traceScheduleNextArrival(trace_t* trace);
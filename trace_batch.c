@@ -0,0 +1,212 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "trace_batch.h"
+
+#define TRACE_BATCH_SEPARATORS " \t\r\n" // characters between the fields of a manifest line
+
+// Add a run to a batch, copying its fields
+// Returns false on allocation failure
+static bool traceBatchAdd(trace_batch_t* batch, const char* traceFilename, const char* outFilename, const char* schedulerName, size_t line)
+{
+    if (batch->count == batch->capacity) {
+        trace_batch_run_t* runs = realloc(batch->runs, 2 * batch->capacity * sizeof(trace_batch_run_t));
+        if (runs == NULL) {
+            return false;
+        }
+        batch->runs = runs;
+        batch->capacity *= 2;
+    }
+    trace_batch_run_t* run = &batch->runs[batch->count];
+    run->traceFilename = strdup(traceFilename);
+    run->outFilename = strdup(outFilename);
+    run->schedulerName = strdup(schedulerName);
+    if (run->traceFilename == NULL || run->outFilename == NULL || run->schedulerName == NULL) {
+        free(run->traceFilename);
+        free(run->outFilename);
+        free(run->schedulerName);
+        return false;
+    }
+    run->line = line;
+    run->ok = false;
+    run->stats.jobs = 0;
+    run->stats.events = 0;
+    run->seconds = 0;
+    batch->count++;
+    return true;
+}
+
+// Returns the run that writes to the given output file, or NULL if there is none
+static trace_batch_run_t* traceBatchFindOutput(trace_batch_t* batch, const char* outFilename)
+{
+    for (size_t i = 0; i < batch->count; i++) {
+        if (strcmp(batch->runs[i].outFilename, outFilename) == 0) {
+            return &batch->runs[i];
+        }
+    }
+    return NULL;
+}
+
+// Read the runs in a manifest into a batch
+// stdinTaken - the manifest itself is read from standard input
+// Returns false if a line is malformed, writes to standard output or to another line's output
+// file, reads standard input when it has already been taken, or on allocation failure
+static bool traceBatchRead(trace_batch_t* batch, FILE* file, const char* manifestFilename, bool stdinTaken)
+{
+    char* text = NULL;
+    size_t size = 0;
+    size_t line = 0;
+    bool ok = true;
+    trace_batch_run_t* other;
+    while (ok && getline(&text, &size, file) != -1) {
+        line++;
+        char* save;
+        char* traceFilename = strtok_r(text, TRACE_BATCH_SEPARATORS, &save);
+        if (traceFilename == NULL || traceFilename[0] == '#') {
+            continue;
+        }
+        char* outFilename = strtok_r(NULL, TRACE_BATCH_SEPARATORS, &save);
+        char* schedulerName = strtok_r(NULL, TRACE_BATCH_SEPARATORS, &save);
+        if (schedulerName == NULL || strtok_r(NULL, TRACE_BATCH_SEPARATORS, &save) != NULL) {
+            printf("Invalid manifest line %zu: %s\n", line, manifestFilename);
+            ok = false;
+        } else if (strcmp(outFilename, TRACE_BATCH_STDOUT) == 0) {
+            // Job output on standard output would interleave with the report
+            printf("Standard output can't be a run's output in a batch, manifest line %zu: %s\n", line, manifestFilename);
+            ok = false;
+        } else if ((other = traceBatchFindOutput(batch, outFilename)) != NULL) {
+            // Two runs writing one file at once would leave it holding parts of both
+            printf("Output file %s is also written by line %zu, manifest line %zu: %s\n", outFilename, other->line, line, manifestFilename);
+            ok = false;
+        } else if (strcmp(traceFilename, TRACE_BATCH_STDIN) == 0 && stdinTaken) {
+            // Runs sharing standard input would each get whatever part of it they read first
+            printf("Standard input can only be read once in a batch, manifest line %zu: %s\n", line, manifestFilename);
+            ok = false;
+        } else {
+            stdinTaken = stdinTaken || strcmp(traceFilename, TRACE_BATCH_STDIN) == 0;
+            ok = traceBatchAdd(batch, traceFilename, outFilename, schedulerName, line);
+        }
+    }
+    free(text);
+    return ok && !ferror(file);
+}
+
+// Read a manifest
+// manifestFilename - path to manifest file, or TRACE_BATCH_STDIN
+// Returns NULL if the file can't be read, a line is malformed, writes to TRACE_BATCH_STDOUT or
+// another line's output file, reads standard input when it's already taken, or on allocation
+// failure
+trace_batch_t* traceBatchOpen(const char* manifestFilename)
+{
+    trace_batch_t* batch = malloc(sizeof(trace_batch_t));
+    if (batch == NULL) {
+        return NULL;
+    }
+    batch->count = 0;
+    batch->capacity = TRACE_BATCH_INITIAL_CAPACITY;
+    batch->options = NULL;
+    atomic_init(&batch->next, 0);
+    batch->runs = malloc(batch->capacity * sizeof(trace_batch_run_t));
+    if (batch->runs == NULL) {
+        free(batch);
+        return NULL;
+    }
+    bool useStdin = strcmp(manifestFilename, TRACE_BATCH_STDIN) == 0;
+    FILE* file = useStdin ? stdin : fopen(manifestFilename, "r");
+    if (file == NULL) {
+        printf("Invalid manifest file: %s\n", manifestFilename);
+        traceBatchDestroy(batch);
+        return NULL;
+    }
+    bool ok = traceBatchRead(batch, file, manifestFilename, useStdin);
+    if (!useStdin) {
+        fclose(file);
+    }
+    if (!ok) {
+        traceBatchDestroy(batch);
+        return NULL;
+    }
+    return batch;
+}
+
+// Destroy a batch
+void traceBatchDestroy(trace_batch_t* batch)
+{
+    for (size_t i = 0; i < batch->count; i++) {
+        free(batch->runs[i].traceFilename);
+        free(batch->runs[i].outFilename);
+        free(batch->runs[i].schedulerName);
+    }
+    free(batch->runs);
+    free(batch);
+}
+
+// Returns the elapsed time in seconds between two timestamps
+static double traceBatchSeconds(struct timespec* start, struct timespec* end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// Batch worker thread, takes runs in manifest order until none are left
+// b - batch
+static void* traceBatchThread(void* b)
+{
+    trace_batch_t* batch = (trace_batch_t*)b;
+    size_t index;
+    while ((index = atomic_fetch_add(&batch->next, 1)) < batch->count) {
+        trace_batch_run_t* run = &batch->runs[index];
+        struct timespec start;
+        struct timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        run->ok = traceRunStats(run->traceFilename, run->outFilename, run->schedulerName, batch->options, &run->stats);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        run->seconds = traceBatchSeconds(&start, &end);
+    }
+    return NULL;
+}
+
+// Run every run in a batch
+// batch - batch to run, each run's results are filled in
+// options - settings for each run, NULL for the defaults
+// threads - most runs at once, the calling thread counts as one
+// Returns true if every run succeeded, false otherwise
+bool traceBatchRun(trace_batch_t* batch, const trace_options_t* options, unsigned threads)
+{
+    batch->options = options;
+    atomic_store(&batch->next, 0);
+    size_t workers = threads < batch->count ? threads : batch->count;
+    size_t helpers = workers > 1 ? workers - 1 : 0;
+    pthread_t* helperThreads = helpers > 0 ? malloc(helpers * sizeof(pthread_t)) : NULL;
+    size_t started = 0;
+    if (helperThreads != NULL) {
+        // A helper that fails to start just leaves more runs for the others
+        while (started < helpers && pthread_create(&helperThreads[started], NULL, traceBatchThread, batch) == 0) {
+            started++;
+        }
+    }
+    traceBatchThread(batch);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(helperThreads[i], NULL);
+    }
+    free(helperThreads);
+    bool ok = true;
+    for (size_t i = 0; i < batch->count; i++) {
+        ok = ok && batch->runs[i].ok;
+    }
+    return ok;
+}
+
+// Write a CSV report of a batch that has been run, one row per run in manifest order
+// batch - batch that has been run
+// file - file to write the report to
+void traceBatchReport(const trace_batch_t* batch, FILE* file)
+{
+    fprintf(file, "line, trace, output, scheduler, status, jobs, events, seconds\n");
+    for (size_t i = 0; i < batch->count; i++) {
+        const trace_batch_run_t* run = &batch->runs[i];
+        fprintf(file, "%zu, %s, %s, %s, %s, %" PRIu64 ", %" PRIu64 ", %.4f\n", run->line, run->traceFilename, run->outFilename, run->schedulerName, run->ok ? "ok" : "failed", run->stats.jobs, run->stats.events, run->seconds);
+    }
+}
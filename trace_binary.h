@@ -0,0 +1,80 @@
+#ifndef TRACE_BINARY_H
+#define TRACE_BINARY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+// Binary trace format
+// A 24 byte header followed by one record per job, all integers little endian:
+//   magic[8] - TRACE_BINARY_MAGIC, the 0x89 lead byte keeps it from ever matching a text trace
+//   version - uint32, TRACE_BINARY_VERSION
+//   reserved - uint32, zero
+//   records - uint64, number of records that follow
+// Each record holds three varints: the zigzag encoded change in id from the previous record,
+// the zigzag encoded change in arrival time and the job time. Changes are taken modulo 2^64
+// so any text trace converts without loss. The first record's changes are from zero.
+
+#define TRACE_BINARY_MAGIC "\x89SIMTRC\n"
+#define TRACE_BINARY_MAGIC_SIZE 8
+#define TRACE_BINARY_VERSION 1
+#define TRACE_BINARY_HEADER_SIZE 24
+#define TRACE_BINARY_MAX_VARINT 10 // bytes needed for a 64 bit varint
+
+// Zigzag encode a change so small steps in either direction stay small
+static inline uint64_t traceBinaryZigzag(uint64_t delta)
+{
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+// Undo traceBinaryZigzag
+static inline uint64_t traceBinaryUnzigzag(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+// Write a varint
+// out - at least TRACE_BINARY_MAX_VARINT bytes
+// Returns the number of bytes written
+static inline size_t traceBinaryPutVarint(uint8_t* out, uint64_t value)
+{
+    size_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = (uint8_t)value;
+    return size;
+}
+
+// Write a little endian integer of the given size
+static inline void traceBinaryPutLittleEndian(uint8_t* out, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+// Read a little endian integer of the given size
+static inline uint64_t traceBinaryGetLittleEndian(const uint8_t* in, size_t size)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= (uint64_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+// Write a header
+// out - TRACE_BINARY_HEADER_SIZE bytes
+// records - number of records that follow
+static inline void traceBinaryPutHeader(uint8_t* out, uint64_t records)
+{
+    memcpy(out, TRACE_BINARY_MAGIC, TRACE_BINARY_MAGIC_SIZE);
+    traceBinaryPutLittleEndian(out + 8, TRACE_BINARY_VERSION, 4);
+    traceBinaryPutLittleEndian(out + 12, 0, 4);
+    traceBinaryPutLittleEndian(out + 16, records, 8);
+}
+
+#endif /* TRACE_BINARY_H */
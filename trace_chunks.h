@@ -0,0 +1,89 @@
+#ifndef TRACE_CHUNKS_H
+#define TRACE_CHUNKS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "trace_reader.h"
+#include "trace_ring.h"
+
+#define TRACE_CHUNK_SIZE ((size_t)4 << 20) // bytes of text parsed by a worker at a time
+#define TRACE_CHUNK_SLOTS_PER_THREAD 2 // parsed chunks held per worker, bounding the memory in use
+#define TRACE_CHUNK_INITIAL_CAPACITY 4096 // records held by a slot before its first resize
+
+// How a worker's parse of a chunk ended
+typedef enum {
+    TRACE_CHUNK_CLEAN, // every record in the chunk was parsed, only whitespace was left
+    TRACE_CHUNK_SPLIT, // the last record runs on past the end of the chunk
+    TRACE_CHUNK_MALFORMED // a record in the chunk can't be parsed, the trace ends there
+} trace_chunk_status_t;
+
+// A chunk parsed by a worker
+typedef struct {
+    trace_record_t* records; // jobs in the chunk in trace order
+    size_t count; // number of jobs
+    size_t capacity; // space in records
+    trace_chunk_status_t status; // how the parse ended
+    const char* stop; // start of the record the parse stopped at
+    bool ready; // parsed and waiting for the simulator
+} trace_chunk_t;
+
+// Parallel chunked parser for a memory mapped text trace
+// The text is cut into TRACE_CHUNK_SIZE chunks, each starting just after a newline, and
+// workers parse the chunks into record arrays while the simulator takes the records in
+// trace order. Since records are whitespace separated a line break is almost always a
+// record boundary, but a record written across lines is split by the cut. The simulator
+// side checks every seam: a chunk that ended cleanly hands over to the next one, a split
+// record hands the rest of the trace to a serial reader starting at that record, and a
+// malformed record ends the trace. The records, the end of file flag and the point where a
+// malformed trace stops are exactly those of the serial reader. Arrival order is left to
+// the simulator, which checks each record as it is scheduled, so a trace that goes back in
+// time fails at the same record with the same output however it was parsed.
+typedef struct {
+    const char* begin; // first byte of the text
+    const char* end; // end of the text
+    size_t chunkCount; // number of chunks the text is cut into
+    trace_chunk_t* slots; // parsed chunks, chunk i lives in slot i % slotCount
+    size_t slotCount; // number of slots
+    size_t nextChunk; // next chunk for a worker to parse
+    size_t consumed; // chunk the simulator side is reading
+    bool stopping; // set to stop the workers
+    pthread_mutex_t lock; // guards nextChunk, consumed, stopping and each slot's ready flag
+    pthread_cond_t readyCond; // signalled when a chunk has been parsed
+    pthread_cond_t freeCond; // signalled when the simulator side gives up a slot
+    pthread_t* threads; // workers
+    size_t threadCount; // workers started
+    trace_chunk_t* current; // chunk being read, NULL between chunks
+    size_t position; // next record in current
+    bool serial; // the rest of the trace is read by tail
+    trace_reader_t tail; // serial reader for the rest of the trace after a split record
+    bool done; // the trace has ended
+    bool eof; // the trace ended at the end of the text, like feof
+} trace_chunks_t;
+
+// Start parsing a trace on worker threads
+// reader - open trace reader, must stay open until the parser is destroyed
+// threads - workers to parse with
+// Returns NULL if the trace isn't a memory mapped text trace, on allocation failure or if
+// no worker can be started, in which case the reader is left for a serial parse
+trace_chunks_t* traceChunksCreate(trace_reader_t* reader, unsigned threads);
+
+// Stop the workers and destroy the parser
+void traceChunksDestroy(trace_chunks_t* chunks);
+
+// Read the next record
+// chunks - parser
+// id - set to the job id
+// arrivalTime - set to the job arrival time
+// jobTime - set to the job time
+// Returns true if all three values were read, false on a malformed record or the end of the trace
+bool traceChunksNext(trace_chunks_t* chunks, uint64_t* id, uint64_t* arrivalTime, uint64_t* jobTime);
+
+// Returns true once a read has reached the end of the trace, like feof
+static inline bool traceChunksEof(trace_chunks_t* chunks)
+{
+    return chunks->serial ? traceReaderEof(&chunks->tail) : chunks->eof;
+}
+
+#endif /* TRACE_CHUNKS_H */
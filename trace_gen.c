@@ -0,0 +1,194 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "trace.h"
+#include "workload.h"
+
+// Synthetic trace generator
+// Writes a generated workload as a trace file, or runs it straight through a scheduler
+// without writing the trace to disk.
+
+static const char* arrivalNames[] = {"poisson", "mmpp", "deterministic"};
+static const char* sizeNames[] = {"exponential", "pareto", "bimodal"};
+
+// Print program usage info
+static void usage(char* program)
+{
+    workload_config_t config;
+    workloadConfigDefault(&config);
+    printf("%s [options]\n", program);
+    printf("Writes a trace to stdout, or to --out, or runs it with --run\n");
+    printf("--jobs N          number of jobs, default %" PRIu64 "\n", config.jobs);
+    printf("--seed N          random seed, default %" PRIu64 "\n", config.seed);
+    printf("--load X          offered load, default %g\n", config.load);
+    printf("--arrivals NAME   poisson, mmpp or deterministic, default poisson\n");
+    printf("--burst X         mmpp burst rate over lull rate, default %g\n", config.burstRatio);
+    printf("--dwell X         mmpp mean time in each state, default %g\n", config.dwellTime);
+    printf("--sizes NAME      exponential, pareto or bimodal, default exponential\n");
+    printf("--mean X          exponential mean job time, default %g\n", config.meanSize);
+    printf("--alpha X         pareto shape, default %g\n", config.paretoAlpha);
+    printf("--min X           pareto smallest job time, default %g\n", config.paretoMin);
+    printf("--max X           pareto largest job time, default %g\n", config.paretoMax);
+    printf("--small X         bimodal small job time, default %g\n", config.smallSize);
+    printf("--large X         bimodal large job time, default %g\n", config.largeSize);
+    printf("--large-prob X    bimodal chance of a large job, default %g\n", config.largeProbability);
+    printf("--out FILE        trace file to write, or simulator output file with --run, - for stdout\n");
+    printf("--run SCHEDULER   run the workload with a scheduler instead of writing the trace\n");
+    printf("--stream          with --run, write the output in completion order instead of by job id\n");
+}
+
+// Returns the index of name in names, or -1 if it isn't there
+static int lookupName(const char* name, const char** names, int count)
+{
+    for (int i = 0; i < count; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Writes the workload as a trace file
+// Returns true on success, false otherwise
+static bool writeTrace(const workload_config_t* config, const char* outFilename)
+{
+    workload_t* workload = workloadCreate(config);
+    if (workload == NULL) {
+        printf("Invalid workload\n");
+        return false;
+    }
+    FILE* outFile = outFilename != NULL && strcmp(outFilename, "-") != 0 ? fopen(outFilename, "w") : stdout;
+    if (outFile == NULL) {
+        printf("Invalid output file: %s\n", outFilename);
+        workloadDestroy(workload);
+        return false;
+    }
+    uint64_t id;
+    uint64_t arrivalTime;
+    uint64_t jobTime;
+    while (workloadNext(workload, &id, &arrivalTime, &jobTime)) {
+        fprintf(outFile, "%" PRIu64 ", %" PRIu64 ", %" PRIu64 "\n", id, arrivalTime, jobTime);
+    }
+    workloadDestroy(workload);
+    bool ok = !ferror(outFile);
+    if (outFile != stdout) {
+        ok = fclose(outFile) == 0 && ok;
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[])
+{
+    static const struct option options[] = {
+        {"jobs", required_argument, NULL, 'n'},
+        {"seed", required_argument, NULL, 's'},
+        {"load", required_argument, NULL, 'l'},
+        {"arrivals", required_argument, NULL, 'a'},
+        {"burst", required_argument, NULL, 'b'},
+        {"dwell", required_argument, NULL, 'w'},
+        {"sizes", required_argument, NULL, 'd'},
+        {"mean", required_argument, NULL, 'm'},
+        {"alpha", required_argument, NULL, 'A'},
+        {"min", required_argument, NULL, 'L'},
+        {"max", required_argument, NULL, 'H'},
+        {"small", required_argument, NULL, 'S'},
+        {"large", required_argument, NULL, 'B'},
+        {"large-prob", required_argument, NULL, 'p'},
+        {"out", required_argument, NULL, 'o'},
+        {"run", required_argument, NULL, 'r'},
+        {"stream", no_argument, NULL, 'c'},
+        {NULL, 0, NULL, 0}
+    };
+    workload_config_t config;
+    workloadConfigDefault(&config);
+    trace_options_t traceOptions;
+    traceOptionsDefault(&traceOptions);
+    const char* outFilename = NULL;
+    const char* schedulerName = NULL;
+    int index;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (opt) {
+        case 'n':
+            config.jobs = strtoull(optarg, NULL, 10);
+            break;
+        case 's':
+            config.seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'l':
+            config.load = strtod(optarg, NULL);
+            break;
+        case 'b':
+            config.burstRatio = strtod(optarg, NULL);
+            break;
+        case 'w':
+            config.dwellTime = strtod(optarg, NULL);
+            break;
+        case 'm':
+            config.meanSize = strtod(optarg, NULL);
+            break;
+        case 'A':
+            config.paretoAlpha = strtod(optarg, NULL);
+            break;
+        case 'L':
+            config.paretoMin = strtod(optarg, NULL);
+            break;
+        case 'H':
+            config.paretoMax = strtod(optarg, NULL);
+            break;
+        case 'S':
+            config.smallSize = strtod(optarg, NULL);
+            break;
+        case 'B':
+            config.largeSize = strtod(optarg, NULL);
+            break;
+        case 'p':
+            config.largeProbability = strtod(optarg, NULL);
+            break;
+        case 'o':
+            outFilename = optarg;
+            break;
+        case 'r':
+            schedulerName = optarg;
+            break;
+        case 'c':
+            traceOptions.outputOrder = TRACE_OUTPUT_COMPLETION_ORDER;
+            break;
+        case 'a':
+            index = lookupName(optarg, arrivalNames, sizeof(arrivalNames) / sizeof(arrivalNames[0]));
+            if (index < 0) {
+                usage(argv[0]);
+                return -1;
+            }
+            config.arrival = (workload_arrival_t)index;
+            break;
+        case 'd':
+            index = lookupName(optarg, sizeNames, sizeof(sizeNames) / sizeof(sizeNames[0]));
+            if (index < 0) {
+                usage(argv[0]);
+                return -1;
+            }
+            config.size = (workload_size_t)index;
+            break;
+        default:
+            usage(argv[0]);
+            return -1;
+        }
+    }
+    if (optind != argc || (schedulerName != NULL && outFilename == NULL)) {
+        usage(argv[0]);
+        return -1;
+    }
+    if (schedulerName != NULL) {
+        trace_stats_t stats;
+        if (!traceRunWorkload(&config, outFilename, schedulerName, &traceOptions, &stats)) {
+            usage(argv[0]);
+            return -2;
+        }
+        fprintf(stderr, "%" PRIu64 " jobs, %" PRIu64 " events\n", stats.jobs, stats.events);
+        return 0;
+    }
+    return writeTrace(&config, outFilename) ? 0 : -2;
+}
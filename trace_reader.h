@@ -0,0 +1,62 @@
+#ifndef TRACE_READER_H
+#define TRACE_READER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define TRACE_READER_BUFFER_SIZE (1 << 16) // bytes read at a time when the trace can't be mapped
+#define TRACE_READER_STDIN "-" // trace filename that reads standard input
+
+// Trace file reader
+// Parses "id, arrival, jobTime" records exactly as fscanf("%lu, %lu, %lu") would, including
+// signs, saturation on overflow and the end of file flag, without going through stdio.
+// Binary traces (see trace_binary.h) are detected from their header and decoded instead.
+// Regular files are memory mapped and parsed in place. Pipes and other files that can't be
+// mapped, such as a trace piped into standard input, are read into a buffer instead.
+typedef struct {
+    int fd; // trace file descriptor
+    const char* pos; // next character to parse
+    const char* end; // end of the parsed data
+    char* map; // mapped trace file, NULL when reading into the buffer
+    size_t mapSize; // size of the mapping
+    char* buffer; // read buffer, NULL when the file is mapped
+    bool inputEnded; // set once the file has no more data to read into the buffer
+    bool eof; // set once parsing has tried to read past the end of the trace, like feof
+    bool binary; // binary trace rather than text
+    uint64_t remaining; // binary records left to read
+    uint64_t lastId; // id of the previous binary record
+    uint64_t lastArrivalTime; // arrival time of the previous binary record
+} trace_reader_t;
+
+// Open a trace file, text or binary
+// filename - path to trace file, or TRACE_READER_STDIN
+// Returns NULL if the file can't be opened, has an unsupported binary version or on allocation failure
+trace_reader_t* traceReaderOpen(const char* filename);
+
+// Set up a reader that parses text already in memory
+// The reader doesn't own the data and must not be closed
+// reader - reader to set up
+// data - text trace, or part of one starting at a record
+// size - bytes of text
+void traceReaderInitMemory(trace_reader_t* reader, const char* data, size_t size);
+
+// Close a trace file
+void traceReaderClose(trace_reader_t* reader);
+
+// Read the next record
+// reader - trace reader
+// id - set to the job id
+// arrivalTime - set to the job arrival time
+// jobTime - set to the job time
+// Returns true if all three values were read, false on a malformed record or the end of the trace
+// A binary trace ends after its record count, a truncated one reads as malformed
+bool traceReaderNext(trace_reader_t* reader, uint64_t* id, uint64_t* arrivalTime, uint64_t* jobTime);
+
+// Returns true once a read has reached the end of the trace, like feof
+static inline bool traceReaderEof(trace_reader_t* reader)
+{
+    return reader->eof;
+}
+
+#endif /* TRACE_READER_H */
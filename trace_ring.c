@@ -0,0 +1,86 @@
+#include <stdlib.h>
+#include <sched.h>
+#include "trace_ring.h"
+
+#define TRACE_RING_SPINS 64 // checks made before yielding the CPU to the other thread
+
+_Static_assert((TRACE_RING_CAPACITY & (TRACE_RING_CAPACITY - 1)) == 0, "trace ring capacity must be a power of two");
+_Static_assert(TRACE_RING_CAPACITY % TRACE_RING_BATCH == 0, "trace ring batch must divide its capacity");
+
+// Create and return an empty ring, or NULL on allocation failure
+trace_ring_t* traceRingCreate(void)
+{
+    trace_ring_t* ring = aligned_alloc(TRACE_RING_CACHE_LINE, sizeof(trace_ring_t));
+    if (ring == NULL) {
+        return NULL;
+    }
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->closed, false);
+    atomic_init(&ring->tail, 0);
+    ring->producerTail = 0;
+    ring->producerHead = 0;
+    ring->consumerHead = 0;
+    ring->consumerTail = 0;
+    return ring;
+}
+
+// Destroy a ring
+void traceRingDestroy(trace_ring_t* ring)
+{
+    free(ring);
+}
+
+// Spin for a while, then give the CPU to the other thread
+// spins - number of times the caller has waited so far
+static inline void traceRingBackoff(unsigned* spins)
+{
+    if (++*spins < TRACE_RING_SPINS) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        sched_yield();
+    }
+}
+
+// Wait for the consumer to free space, called by traceRingPush when the ring looks full
+void traceRingWaitSpace(trace_ring_t* ring)
+{
+    // The consumer may be waiting on records this side hasn't published yet
+    atomic_store_explicit(&ring->tail, ring->producerTail, memory_order_release);
+    unsigned spins = 0;
+    ring->producerHead = atomic_load_explicit(&ring->head, memory_order_acquire);
+    while (ring->producerTail - ring->producerHead == TRACE_RING_CAPACITY) {
+        traceRingBackoff(&spins);
+        ring->producerHead = atomic_load_explicit(&ring->head, memory_order_acquire);
+    }
+}
+
+// Wait for the producer to push records, called by traceRingPop when the ring looks empty
+// Returns false once the ring is closed and empty
+bool traceRingWaitRecords(trace_ring_t* ring)
+{
+    // The producer may be waiting on space this side hasn't published yet
+    atomic_store_explicit(&ring->head, ring->consumerHead, memory_order_release);
+    unsigned spins = 0;
+    for (;;) {
+        ring->consumerTail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        if (ring->consumerTail != ring->consumerHead) {
+            return true;
+        }
+        if (atomic_load_explicit(&ring->closed, memory_order_acquire)) {
+            // The final tail is published before closed is set
+            ring->consumerTail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+            return ring->consumerTail != ring->consumerHead;
+        }
+        traceRingBackoff(&spins);
+    }
+}
+
+// Publish every pushed record and close the ring
+// Only the producer may call this, and it may not push afterwards
+void traceRingClose(trace_ring_t* ring)
+{
+    atomic_store_explicit(&ring->tail, ring->producerTail, memory_order_release);
+    atomic_store_explicit(&ring->closed, true, memory_order_release);
+}
@@ -0,0 +1,82 @@
+#ifndef TRACE_RING_H
+#define TRACE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define TRACE_RING_CAPACITY 4096 // records per ring, a power of two
+#define TRACE_RING_BATCH 64 // records moved before the other thread is told about them
+#define TRACE_RING_CACHE_LINE 64 // keeps each thread's indexes on its own cache line
+
+// Record passed between pipeline threads
+typedef struct {
+    uint64_t id; // job id
+    uint64_t time; // arrival time of a job, or completion time
+    uint64_t jobTime; // job time, unused for completions
+} trace_record_t;
+
+// Lock-free single producer, single consumer ring of trace records
+// Each side works on a private copy of its index and only publishes it every
+// TRACE_RING_BATCH records, or when it has to wait, so the shared cache lines change
+// hands rarely. A side that has to wait spins briefly and then yields its CPU.
+typedef struct {
+    _Alignas(TRACE_RING_CACHE_LINE) _Atomic size_t head; // next record to pop, published by the consumer
+    _Atomic bool closed; // set by the producer once no more records will come
+    _Alignas(TRACE_RING_CACHE_LINE) _Atomic size_t tail; // next record to push, published by the producer
+    _Alignas(TRACE_RING_CACHE_LINE) size_t producerTail; // producer's unpublished tail
+    size_t producerHead; // producer's last view of head
+    _Alignas(TRACE_RING_CACHE_LINE) size_t consumerHead; // consumer's unpublished head
+    size_t consumerTail; // consumer's last view of tail
+    _Alignas(TRACE_RING_CACHE_LINE) trace_record_t records[TRACE_RING_CAPACITY]; // ring storage
+} trace_ring_t;
+
+// Create and return an empty ring, or NULL on allocation failure
+trace_ring_t* traceRingCreate(void);
+
+// Destroy a ring
+void traceRingDestroy(trace_ring_t* ring);
+
+// Wait for the consumer to free space, called by traceRingPush when the ring looks full
+void traceRingWaitSpace(trace_ring_t* ring);
+
+// Wait for the producer to push records, called by traceRingPop when the ring looks empty
+// Returns false once the ring is closed and empty
+bool traceRingWaitRecords(trace_ring_t* ring);
+
+// Publish every pushed record and close the ring
+// Only the producer may call this, and it may not push afterwards
+void traceRingClose(trace_ring_t* ring);
+
+// Add a record, waiting for space if the ring is full
+// Only the producer thread may call this
+static inline void traceRingPush(trace_ring_t* ring, const trace_record_t* record)
+{
+    if (ring->producerTail - ring->producerHead == TRACE_RING_CAPACITY) {
+        traceRingWaitSpace(ring);
+    }
+    ring->records[ring->producerTail & (TRACE_RING_CAPACITY - 1)] = *record;
+    ring->producerTail++;
+    if (ring->producerTail % TRACE_RING_BATCH == 0) {
+        atomic_store_explicit(&ring->tail, ring->producerTail, memory_order_release);
+    }
+}
+
+// Remove the oldest record, waiting for one if the ring is empty
+// Only the consumer thread may call this
+// Returns false once the ring is closed and every record has been popped
+static inline bool traceRingPop(trace_ring_t* ring, trace_record_t* record)
+{
+    if (ring->consumerHead == ring->consumerTail && !traceRingWaitRecords(ring)) {
+        return false;
+    }
+    *record = ring->records[ring->consumerHead & (TRACE_RING_CAPACITY - 1)];
+    ring->consumerHead++;
+    if (ring->consumerHead % TRACE_RING_BATCH == 0) {
+        atomic_store_explicit(&ring->head, ring->consumerHead, memory_order_release);
+    }
+    return true;
+}
+
+#endif /* TRACE_RING_H */
@@ -0,0 +1,124 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "trace_writer.h"
+
+// Two digit pairs, so integers format two digits per step
+static const char traceWriterDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Open an output file, truncating it like fopen with "w"
+// filename - path to output file, or TRACE_WRITER_STDOUT
+// Returns NULL if the file can't be opened or on allocation failure
+trace_writer_t* traceWriterOpen(const char* filename)
+{
+    trace_writer_t* writer = malloc(sizeof(trace_writer_t));
+    if (writer == NULL) {
+        return NULL;
+    }
+    writer->buffer = malloc(TRACE_WRITER_BUFFER_SIZE);
+    if (writer->buffer == NULL) {
+        free(writer);
+        return NULL;
+    }
+    // Standard output is duplicated so closing the writer never closes it
+    if (strcmp(filename, TRACE_WRITER_STDOUT) == 0) {
+        writer->fd = dup(STDOUT_FILENO);
+    } else {
+        writer->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    }
+    if (writer->fd < 0) {
+        free(writer->buffer);
+        free(writer);
+        return NULL;
+    }
+    writer->used = 0;
+    writer->error = false;
+    return writer;
+}
+
+// Flush and close an output file
+// Returns false if any write failed
+bool traceWriterClose(trace_writer_t* writer)
+{
+    bool ok = traceWriterFlush(writer);
+    if (close(writer->fd) != 0) {
+        ok = false;
+    }
+    free(writer->buffer);
+    free(writer);
+    return ok;
+}
+
+// Write out everything in the buffer
+// Returns false if the write failed
+bool traceWriterFlush(trace_writer_t* writer)
+{
+    size_t written = 0;
+    while (written < writer->used && !writer->error) {
+        ssize_t bytes = write(writer->fd, writer->buffer + written, writer->used - written);
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            writer->error = true;
+            break;
+        }
+        written += (size_t)bytes;
+    }
+    // Output after a failed write is dropped, like a stream stuck in its error state
+    writer->used = 0;
+    return !writer->error;
+}
+
+// Format an integer in decimal
+// out - at least 20 bytes
+// Returns the number of characters written
+static inline size_t traceWriterFormat(char* out, uint64_t value)
+{
+    char digits[20];
+    char* start = digits + sizeof(digits);
+    while (value >= 100) {
+        start -= 2;
+        memcpy(start, &traceWriterDigitPairs[(value % 100) * 2], 2);
+        value /= 100;
+    }
+    if (value >= 10) {
+        start -= 2;
+        memcpy(start, &traceWriterDigitPairs[value * 2], 2);
+    } else {
+        *--start = (char)('0' + value);
+    }
+    size_t size = (size_t)(digits + sizeof(digits) - start);
+    memcpy(out, start, size);
+    return size;
+}
+
+// Write a completion line, "id, time\n"
+// writer - output writer
+// id - job id
+// time - completion time
+void traceWriterCompletion(trace_writer_t* writer, uint64_t id, uint64_t time)
+{
+    if (TRACE_WRITER_BUFFER_SIZE - writer->used < TRACE_WRITER_MAX_LINE) {
+        traceWriterFlush(writer);
+    }
+    char* out = writer->buffer + writer->used;
+    size_t size = traceWriterFormat(out, id);
+    out[size++] = ',';
+    out[size++] = ' ';
+    size += traceWriterFormat(out + size, time);
+    out[size++] = '\n';
+    writer->used += size;
+}
@@ -0,0 +1,76 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Synthetic workload generator
+// Produces jobs in the trace format (id, arrival, jobTime) with ids counting up from 1
+// and arrivals in time order. The same configuration and seed always produce the same jobs.
+
+typedef enum {
+    WORKLOAD_ARRIVAL_POISSON, // exponential interarrival times
+    WORKLOAD_ARRIVAL_MMPP, // two state Markov modulated Poisson process, alternating bursts and lulls
+    WORKLOAD_ARRIVAL_DETERMINISTIC // fixed interarrival time
+} workload_arrival_t;
+
+typedef enum {
+    WORKLOAD_SIZE_EXPONENTIAL, // exponential job times
+    WORKLOAD_SIZE_BOUNDED_PARETO, // heavy tailed job times between a minimum and maximum
+    WORKLOAD_SIZE_BIMODAL // mostly small jobs with some large ones
+} workload_size_t;
+
+typedef struct {
+    uint64_t jobs; // number of jobs to generate
+    uint64_t seed; // random seed
+    double load; // offered load, mean job time over mean interarrival time
+    workload_arrival_t arrival; // arrival process
+    double burstRatio; // MMPP arrival rate in a burst over the rate in a lull
+    double dwellTime; // MMPP mean time spent in each state
+    workload_size_t size; // job time distribution
+    double meanSize; // exponential mean job time
+    double paretoAlpha; // bounded Pareto shape
+    double paretoMin; // bounded Pareto smallest job time
+    double paretoMax; // bounded Pareto largest job time
+    double smallSize; // bimodal small job time
+    double largeSize; // bimodal large job time
+    double largeProbability; // bimodal chance of a large job
+} workload_config_t;
+
+typedef struct {
+    workload_config_t config; // configuration the workload was created with
+    uint64_t rng; // random state
+    uint64_t nextId; // id of the next job
+    double clock; // arrival time of the previous job
+    double meanInterarrival; // mean time between arrivals for the requested load
+    double burstRate; // MMPP arrival rate in a burst
+    double lullRate; // MMPP arrival rate in a lull
+    double stateEnd; // MMPP time of the next state change
+    bool burst; // MMPP currently in a burst
+} workload_t;
+
+// Fill in the default configuration
+// Poisson arrivals and exponential job times with mean 10 at a load of 0.8
+// config - configuration to fill in
+void workloadConfigDefault(workload_config_t* config);
+
+// Returns the mean job time of a configuration
+double workloadMeanSize(const workload_config_t* config);
+
+// Create a workload generator
+// config - configuration, copied into the generator
+// Returns NULL if the configuration is invalid or on allocation failure
+workload_t* workloadCreate(const workload_config_t* config);
+
+// Destroy a workload generator
+void workloadDestroy(workload_t* workload);
+
+// Generate the next job
+// workload - generator
+// id - set to the job id
+// arrivalTime - set to the job arrival time
+// jobTime - set to the job time, at least 1
+// Returns false once all the jobs have been generated
+bool workloadNext(workload_t* workload, uint64_t* id, uint64_t* arrivalTime, uint64_t* jobTime);
+
+#endif /* WORKLOAD_H */